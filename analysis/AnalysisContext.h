@@ -1,16 +1,66 @@
 #pragma once
 
 #include "../core/Timestamp.h"
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace loganalyzer {
 
+class IAnalyzer;
+
+// Creates one analyzer instance; called once per worker thread
+using AnalyzerFactory = std::function<std::unique_ptr<IAnalyzer>()>;
+
+// How regular files are read
+enum class IoBackend {
+  Mmap, // Mapped and split into morsels (see MemoryMappedFile)
+  Pread // Read into reusable blocks with pread() (see StreamReader)
+};
+
 struct AnalysisContext {
   std::optional<Timestamp> fromTs;
   std::optional<Timestamp> toTs;
   std::optional<std::string> keyword;
   std::string customPattern; // If non-empty, use PatternLogParser
+
+  // Optional outputs; switching one off also stops the parser from
+  // extracting fields only it needed (see QueryPlan)
+  bool countLevels = true;
+  bool topErrors = true;
+  size_t topErrorCount = 10; // Messages listed in topErrors
+  // Above 0, top errors are approximate but use fixed memory: this many
+  // Space-Saving counters per thread (see BoundedTopErrorAnalyzer)
+  size_t topErrorCapacity = 0;
+  bool timeline = true; // Timeline and heatmap
+
+  // Analyzers of your own, run next to the built-in ones (see
+  // PipelineBuilder)
+  std::vector<AnalyzerFactory> extraAnalyzers;
+
+  IoBackend io = IoBackend::Mmap;
+
+  // Memory-mapped input (see MemoryMappedFile::Options). With readahead
+  // the mapping is read sequentially: each worker has the kernel read
+  // ahead of its morsel and drops the pages behind it.
+  bool mapReadahead = true;
+  bool mapPopulate = false;
+  bool mapHugePages = false;
+  // Above 0, files are not mapped whole: each worker maps only the window
+  // it parses and evicts it afterwards, so mapped memory stays around this
+  // many bytes whatever the file size (plus any single longer line)
+  uint64_t mapBudget = 0;
+
+  // Worker threads; 0 uses the shared ThreadPool::instance()
+  unsigned threads = 0;
+
+  // Optional cancel flag owned by the caller. Workers check it once per
+  // line block, so setting it stops the run without waiting for the next
+  // progress callback.
+  const std::atomic<bool> *stopToken = nullptr;
 };
 
 } // namespace loganalyzer
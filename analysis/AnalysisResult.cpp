@@ -1,15 +1,107 @@
 #include "AnalysisResult.h"
 #include <algorithm>
 #include <map>
+#include <type_traits>
+#include <utility>
 
 namespace loganalyzer {
 
+namespace {
+
+// splitmix64 finalizer: offsets -> well-spread sampling keys
+uint64_t samplePriority(uint64_t offset) {
+  uint64_t z = offset + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// Samples stay sorted by priority, at most kMaxErrorSamples of them
+bool wouldKeep(const std::vector<AnalysisResult::ErrorSample> &samples,
+               uint64_t priority) {
+  return samples.size() < AnalysisResult::kMaxErrorSamples ||
+         priority < samples.back().priority;
+}
+
+void keepSample(std::vector<AnalysisResult::ErrorSample> &samples,
+                AnalysisResult::ErrorSample &&sample) {
+  auto pos = std::upper_bound(
+      samples.begin(), samples.end(), sample.priority,
+      [](uint64_t p, const auto &s) { return p < s.priority; });
+  samples.insert(pos, std::move(sample));
+  if (samples.size() > AnalysisResult::kMaxErrorSamples)
+    samples.pop_back();
+}
+
+// Linear merge of two tables sorted by (hash, message). Entries of an
+// rvalue table are moved rather than copied.
+template <typename Counts>
+void mergeErrorCounts(std::vector<AnalysisResult::ErrorCount> &mine,
+                      Counts &&theirs) {
+  constexpr bool kMove = std::is_rvalue_reference_v<Counts &&>;
+  if (theirs.empty())
+    return;
+  if (mine.empty()) {
+    mine = std::forward<Counts>(theirs);
+    return;
+  }
+
+  std::vector<AnalysisResult::ErrorCount> counts;
+  counts.reserve(mine.size() + theirs.size());
+  auto a = mine.begin();
+  auto b = theirs.begin();
+  while (a != mine.end() || b != theirs.end()) {
+    if (b == theirs.end() || (a != mine.end() && *a < *b)) {
+      counts.push_back(std::move(*a++));
+    } else if (a == mine.end() || *b < *a) {
+      if constexpr (kMove)
+        counts.push_back(std::move(*b++));
+      else
+        counts.push_back(*b++);
+    } else {
+      a->count += b->count;
+      counts.push_back(std::move(*a++));
+      ++b;
+    }
+  }
+  mine = std::move(counts);
+}
+
+} // namespace
+
+void AnalysisResult::addErrorSample(ParseErrorCode code, uint64_t offset,
+                                    uint64_t lineNumber,
+                                    std::string_view line) {
+  auto &samples = errorSamples[code];
+  uint64_t priority = samplePriority(offset);
+  if (!wouldKeep(samples, priority))
+    return;
+
+  std::string text(line.substr(0, kMaxSampleLength));
+  for (char &c : text) {
+    if (static_cast<unsigned char>(c) < 0x20 || c == 0x7F)
+      c = '?';
+  }
+  keepSample(samples, {offset, lineNumber, priority, std::move(text)});
+}
+
+void AnalysisResult::merge(AnalysisResult &&other) {
+  // The count tables hold every distinct message: take them over instead
+  // of copying the strings
+  std::vector<ErrorCount> theirs = std::move(other.errorCounts);
+  other.errorCounts.clear();
+  merge(static_cast<const AnalysisResult &>(other));
+  mergeErrorCounts(errorCounts, std::move(theirs));
+}
+
 void AnalysisResult::merge(const AnalysisResult &other) {
   totalLines += other.totalLines;
   parsedLines += other.parsedLines;
   invalidLines += other.invalidLines;
   keywordHits += other.keywordHits;
   timeRangeMatched += other.timeRangeMatched;
+  timestampCacheHits += other.timestampCacheHits;
+  timestampCacheMisses += other.timestampCacheMisses;
 
   // Merge maps
   for (const auto &[code, count] : other.parseErrors) {
@@ -20,6 +112,36 @@ void AnalysisResult::merge(const AnalysisResult &other) {
     levelCounts[level] += count;
   }
 
+  // Files with the same path are summed; sample file indices follow
+  std::vector<uint32_t> fileIndex(other.files.size());
+  for (size_t i = 0; i < other.files.size(); ++i) {
+    const FileSummary &theirs = other.files[i];
+    auto it = std::find_if(files.begin(), files.end(), [&](const auto &f) {
+      return f.path == theirs.path;
+    });
+    if (it == files.end()) {
+      files.push_back(FileSummary{theirs.path, 0, 0, 0, 0});
+      it = files.end() - 1;
+    }
+    it->bytes += theirs.bytes;
+    it->totalLines += theirs.totalLines;
+    it->parsedLines += theirs.parsedLines;
+    it->invalidLines += theirs.invalidLines;
+    fileIndex[i] = static_cast<uint32_t>(it - files.begin());
+  }
+
+  for (const auto &[code, samples] : other.errorSamples) {
+    auto &mine = errorSamples[code];
+    for (const auto &sample : samples) {
+      if (!wouldKeep(mine, sample.priority))
+        continue;
+      ErrorSample copy(sample);
+      if (copy.file < fileIndex.size())
+        copy.file = fileIndex[copy.file];
+      keepSample(mine, std::move(copy));
+    }
+  }
+
   // Merge Heatmap
   for (size_t d = 0; d < 7; ++d) {
     for (size_t h = 0; h < 24; ++h) {
@@ -28,41 +150,82 @@ void AnalysisResult::merge(const AnalysisResult &other) {
   }
 
   // Merge Timeline
-  // NOTE: Simple concatenation. Sorting should happen at the end of pipeline.
-  // Ideally, specialized merging that buckets by minute would be better,
-  // but for now, append and let the GUI or finalizer sort it.
+  // NOTE: Simple concatenation. Call coalesceTimeline() once everything is
+  // merged.
   timeline.insert(timeline.end(), other.timeline.begin(), other.timeline.end());
 
-  // Merge topErrors
-  // Strategy: Combine both vectors into a map to sum counts, then recreate
-  // vector
-  std::map<std::string, uint64_t> errorMap;
+  workerStats.insert(workerStats.end(), other.workerStats.begin(),
+                     other.workerStats.end());
 
-  // Add current
-  for (const auto &pair : topErrors) {
-    errorMap[pair.first] += pair.second;
-  }
+  custom.merge(other.custom);
+
+  // Merge the full tables, so topErrors stays exact. Selecting is left to
+  // selectTopErrors() once everything is merged.
+  topErrorLimit = std::max(topErrorLimit, other.topErrorLimit);
+  errorSketch.merge(other.errorSketch);
+  mergeErrorCounts(errorCounts, other.errorCounts);
+}
 
-  // Add other
-  for (const auto &pair : other.topErrors) {
-    errorMap[pair.first] += pair.second;
+void AnalysisResult::selectTopErrors() {
+  topErrors.clear();
+  topErrorBounds.clear();
+  if (errorSketch.capacity > 0) {
+    std::vector<const ErrorSketch::Counter *> ranked;
+    ranked.reserve(errorSketch.counters.size());
+    for (const ErrorSketch::Counter &counter : errorSketch.counters)
+      ranked.push_back(&counter);
+
+    auto before = [](const auto *a, const auto *b) {
+      return a->count != b->count ? a->count > b->count
+                                  : a->message < b->message;
+    };
+    const size_t limit = std::min(ranked.size(), topErrorLimit);
+    std::partial_sort(ranked.begin(), ranked.begin() + limit, ranked.end(),
+                      before);
+    for (size_t i = 0; i < limit; ++i) {
+      topErrors.emplace_back(ranked[i]->message, ranked[i]->count);
+      topErrorBounds.push_back(ranked[i]->error);
+    }
+    return;
   }
 
-  // Convert back to vector
-  std::vector<std::pair<std::string, uint64_t>> vec(errorMap.begin(),
-                                                    errorMap.end());
+  std::vector<const ErrorCount *> ranked;
+  ranked.reserve(errorCounts.size());
+  for (const ErrorCount &entry : errorCounts)
+    ranked.push_back(&entry);
 
-  // Sort: descending by count, then alphabetically
-  std::sort(vec.begin(), vec.end(), [](const auto &a, const auto &b) {
-    if (a.second != b.second) {
-      return a.second > b.second; // Higher count first
+  // Sort: descending by count, then alphabetically (deterministic)
+  auto before = [](const ErrorCount *a, const ErrorCount *b) {
+    if (a->count != b->count) {
+      return a->count > b->count; // Higher count first
     }
-    return a.first < b.first; // Alphabetical tie-break
-  });
+    return a->message < b->message; // Alphabetical tie-break
+  };
 
-  // Limit to top 10
-  size_t limit = std::min(vec.size(), size_t(10));
-  topErrors.assign(vec.begin(), vec.begin() + limit);
+  // Only the top K are ordered
+  const size_t limit = std::min(ranked.size(), topErrorLimit);
+  std::nth_element(ranked.begin(), ranked.begin() + limit, ranked.end(),
+                   before);
+  std::sort(ranked.begin(), ranked.begin() + limit, before);
+
+  for (size_t i = 0; i < limit; ++i)
+    topErrors.emplace_back(ranked[i]->message, ranked[i]->count);
+}
+
+void AnalysisResult::coalesceTimeline() {
+  std::sort(timeline.begin(), timeline.end(), [](const auto &a, const auto &b) {
+    return a.timestamp < b.timestamp;
+  });
+  size_t out = 0;
+  for (size_t i = 0; i < timeline.size(); ++i) {
+    if (out > 0 && timeline[out - 1].timestamp == timeline[i].timestamp) {
+      timeline[out - 1].errorCount += timeline[i].errorCount;
+      timeline[out - 1].warningCount += timeline[i].warningCount;
+    } else {
+      timeline[out++] = timeline[i];
+    }
+  }
+  timeline.resize(out);
 }
 
 } // namespace loganalyzer
@@ -2,10 +2,13 @@
 
 #include "../core/LogLevel.h"
 #include "../core/ParseError.h"
+#include "ErrorSketch.h"
+#include "ResultSlots.h"
 #include <array>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -17,31 +20,109 @@ struct AnalysisResult {
   uint64_t invalidLines = 0;
 
   std::map<ParseErrorCode, uint64_t> parseErrors;
+
+  // A few example invalid lines per error code, copied out of the input.
+  // Kept by lowest hash of the byte offset (bottom-k sampling): spread over
+  // the whole file, independent of how it was split across threads, and
+  // cheap to merge. Only a kept line is copied.
+  struct ErrorSample {
+    uint64_t offset;     // Byte offset of the line in its file
+    uint64_t lineNumber; // 1-based line number in its file
+    uint64_t priority;   // Sampling key, lowest kept
+    std::string line;  // Truncated, control characters replaced by '?'
+    uint32_t file = 0; // Index into files
+  };
+  static constexpr size_t kMaxErrorSamples = 5;
+  static constexpr size_t kMaxSampleLength = 160;
+  std::map<ParseErrorCode, std::vector<ErrorSample>> errorSamples;
+
+  void addErrorSample(ParseErrorCode code, uint64_t offset,
+                      uint64_t lineNumber, std::string_view line);
   std::map<LogLevel, uint64_t> levelCounts;
 
+  // Per input file, in input order. Runs over several files also fill the
+  // totals above with the sum over all of them.
+  struct FileSummary {
+    std::string path;
+    uint64_t bytes = 0;
+    uint64_t totalLines = 0;
+    uint64_t parsedLines = 0;
+    uint64_t invalidLines = 0;
+  };
+  std::vector<FileSummary> files;
+
   uint64_t keywordHits = 0;
   uint64_t timeRangeMatched = 0;
 
-  // Top 10 ERROR messages: (message, count), deterministically sorted
+  // Parser timestamp prefix memo (StandardLogParser). Per worker, so not
+  // deterministic; kept out of the text report like workerStats.
+  uint64_t timestampCacheHits = 0;
+  uint64_t timestampCacheMisses = 0;
+
+  // Results of analyzers added through PipelineBuilder, by name
+  ResultSlots custom;
+
+  // The topErrorLimit most frequent ERROR messages: (message, count),
+  // deterministically sorted
   std::vector<std::pair<std::string, uint64_t>> topErrors;
+  size_t topErrorLimit = 0; // 0 until a TopErrorAnalyzer ran
+  // Count of every ERROR message. Merged in full, so topErrors of a merged
+  // result is exact: a message that is 11th in every thread's share can
+  // still be 1st overall. Sorted by (hash, message) for a linear merge.
+  struct ErrorCount {
+    uint64_t hash; // std::hash of message; only meaningful in this process
+    std::string message;
+    uint64_t count;
+
+    bool operator<(const ErrorCount &other) const {
+      return hash != other.hash ? hash < other.hash : message < other.message;
+    }
+  };
+  std::vector<ErrorCount> errorCounts;
+  // Bounded mode instead of errorCounts (see BoundedTopErrorAnalyzer).
+  // topErrors is then approximate: the true count of topErrors[i] lies in
+  // [count - topErrorBounds[i], count].
+  ErrorSketch errorSketch;
+  std::vector<uint64_t> topErrorBounds;
 
   // Timeline Data: Minute-by-minute error/warning counts
   // Storing simple counts per minute bucket (relative to start time or
   // absolute?) Let's store absolute timestamps (rounded to minute) -> count
   // Using vector of pairs for determinism and easy plotting
   struct TimelineBucket {
-    uint64_t timestamp; // Unix timestamp for minute
+    int64_t timestamp; // Unix timestamp for minute
     uint32_t errorCount;
     uint32_t warningCount;
   };
   std::vector<TimelineBucket> timeline;
 
+  // Per pool worker: time spent in morsels, to check the load balance.
+  // Not deterministic; kept out of the text report.
+  struct WorkerStats {
+    unsigned worker = 0;
+    double busySeconds = 0;
+    uint64_t morsels = 0;
+    uint64_t bytes = 0;
+  };
+  std::vector<WorkerStats> workerStats;
+
   // Heatmap Data: 7 Days x 24 Hours
   // heatmap[day_of_week][hour_of_day] = count
   // day 0 = Sunday, 1 = Monday ... 6 = Saturday
   std::array<std::array<uint32_t, 24>, 7> heatmap = {};
 
+  // Leaves topErrors stale: call selectTopErrors() (and
+  // coalesceTimeline()) once everything is merged
   void merge(const AnalysisResult &other);
+  // Same, moving other's error count table instead of copying it
+  void merge(AnalysisResult &&other);
+
+  // Fill topErrors (and topErrorBounds) from errorCounts or errorSketch
+  void selectTopErrors();
+
+  // Sort the timeline and sum buckets of the same minute, as left behind
+  // by merge()
+  void coalesceTimeline();
 };
 
 } // namespace loganalyzer
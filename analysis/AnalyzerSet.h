@@ -0,0 +1,68 @@
+#pragma once
+
+#include "IAnalyzer.h"
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief The analyzers of one worker, composed at compile time.
+ *
+ * Holds each analyzer by value, so process() calls the concrete (final)
+ * classes directly and the calls inline into the pipeline's line loop
+ * instead of going through one virtual call per analyzer per line.
+ * QueryPlan::makeAnalyzerSet picks an instantiation for the context.
+ */
+template <Analyzer... Analyzers> class AnalyzerSet {
+public:
+  explicit AnalyzerSet(Analyzers... analyzers)
+      : analyzers_(std::move(analyzers)...) {}
+
+  bool empty() const { return sizeof...(Analyzers) == 0; }
+
+  void process(const LogEntry &entry) {
+    std::apply([&](Analyzers &...a) { (a.process(entry), ...); },
+               analyzers_);
+  }
+
+  void finalize(AnalysisResult &result) {
+    std::apply([&](Analyzers &...a) { (a.finalize(result), ...); },
+               analyzers_);
+  }
+
+private:
+  std::tuple<Analyzers...> analyzers_;
+};
+
+/**
+ * @brief Any mix of analyzers behind IAnalyzer, for combinations without a
+ * compile-time instantiation and for analyzers added at runtime.
+ */
+class DynamicAnalyzerSet {
+public:
+  explicit DynamicAnalyzerSet(
+      std::vector<std::unique_ptr<IAnalyzer>> analyzers)
+      : analyzers_(std::move(analyzers)) {}
+
+  bool empty() const { return analyzers_.empty(); }
+
+  void process(const LogEntry &entry) {
+    for (auto &analyzer : analyzers_) {
+      analyzer->process(entry);
+    }
+  }
+
+  void finalize(AnalysisResult &result) {
+    for (auto &analyzer : analyzers_) {
+      analyzer->finalize(result);
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<IAnalyzer>> analyzers_;
+};
+
+} // namespace loganalyzer
@@ -0,0 +1,86 @@
+#include "BoundedTopErrorAnalyzer.h"
+#include <algorithm>
+#include <utility>
+
+namespace loganalyzer {
+
+BoundedTopErrorAnalyzer::BoundedTopErrorAnalyzer(size_t capacity, size_t topN)
+    : capacity_(std::max<size_t>(capacity, 1)), topN_(topN) {
+  counters_.reserve(capacity_);
+  heap_.reserve(capacity_);
+  heapPos_.reserve(capacity_);
+  index_.reserve(capacity_);
+}
+
+void BoundedTopErrorAnalyzer::process(const LogEntry &entry) {
+  // Only track ERROR level messages
+  if (entry.level != LogLevel::ERROR)
+    return;
+
+  auto it = index_.find(entry.message);
+  if (it != index_.end()) {
+    counters_[it->second].count++;
+    siftDown(heapPos_[it->second]);
+    return;
+  }
+
+  if (counters_.size() < capacity_) {
+    const auto slot = static_cast<uint32_t>(counters_.size());
+    counters_.push_back({std::string(entry.message), 1, 0});
+    heap_.push_back(slot);
+    heapPos_.push_back(slot);
+    siftUp(slot);
+    index_.emplace(counters_[slot].message, slot);
+    return;
+  }
+
+  // Take over the smallest counter; the new message may have occurred up
+  // to that many times before without being counted
+  const uint32_t slot = heap_.front();
+  ErrorSketch::Counter &counter = counters_[slot];
+  index_.erase(counter.message);
+  counter.message.assign(entry.message);
+  counter.error = counter.count;
+  counter.count++;
+  index_.emplace(counter.message, slot);
+  siftDown(0);
+}
+
+void BoundedTopErrorAnalyzer::swapHeap(size_t a, size_t b) {
+  std::swap(heap_[a], heap_[b]);
+  heapPos_[heap_[a]] = static_cast<uint32_t>(a);
+  heapPos_[heap_[b]] = static_cast<uint32_t>(b);
+}
+
+void BoundedTopErrorAnalyzer::siftDown(size_t pos) {
+  while (true) {
+    size_t smallest = pos;
+    for (size_t child = 2 * pos + 1; child <= 2 * pos + 2; ++child) {
+      if (child < heap_.size() && counters_[heap_[child]].count <
+                                      counters_[heap_[smallest]].count)
+        smallest = child;
+    }
+    if (smallest == pos)
+      return;
+    swapHeap(pos, smallest);
+    pos = smallest;
+  }
+}
+
+void BoundedTopErrorAnalyzer::siftUp(size_t pos) {
+  while (pos > 0) {
+    const size_t parent = (pos - 1) / 2;
+    if (counters_[heap_[parent]].count <= counters_[heap_[pos]].count)
+      return;
+    swapHeap(pos, parent);
+    pos = parent;
+  }
+}
+
+void BoundedTopErrorAnalyzer::finalize(AnalysisResult &result) {
+  result.errorSketch.capacity = capacity_;
+  result.errorSketch.counters = counters_;
+  result.topErrorLimit = topN_;
+}
+
+} // namespace loganalyzer
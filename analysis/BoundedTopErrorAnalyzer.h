@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ErrorSketch.h"
+#include "IAnalyzer.h"
+#include "TopErrorAnalyzer.h"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Approximate top ERROR messages in fixed memory (Space-Saving).
+ *
+ * For services where almost every message is unique (IDs, timestamps),
+ * TopErrorAnalyzer's table grows with the input. This analyzer keeps at
+ * most capacity counters: a message without one takes over the counter
+ * with the smallest count. Memory is bounded by capacity times the
+ * longest message. finalize() writes an ErrorSketch, so per-thread
+ * results merge; selectTopErrors() then gives topErrors with per-entry
+ * error bounds.
+ */
+class BoundedTopErrorAnalyzer final : public IAnalyzer {
+public:
+  static constexpr size_t kDefaultCapacity = 4096;
+
+  explicit BoundedTopErrorAnalyzer(
+      size_t capacity = kDefaultCapacity,
+      size_t topN = TopErrorAnalyzer::kDefaultTopN);
+
+  // index_ views messages in counters_: moving keeps them, copying not
+  BoundedTopErrorAnalyzer(BoundedTopErrorAnalyzer &&) = default;
+  BoundedTopErrorAnalyzer &operator=(BoundedTopErrorAnalyzer &&) = default;
+  BoundedTopErrorAnalyzer(const BoundedTopErrorAnalyzer &) = delete;
+  BoundedTopErrorAnalyzer &operator=(const BoundedTopErrorAnalyzer &) = delete;
+
+  void process(const LogEntry &entry) override;
+  void finalize(AnalysisResult &result) override;
+  ParseFields requiredFields() const override { return {false, true, true}; }
+
+private:
+  // Restores the min-heap from heap position pos downwards
+  void siftDown(size_t pos);
+  void siftUp(size_t pos);
+  void swapHeap(size_t a, size_t b);
+
+  size_t capacity_;
+  size_t topN_;
+  // Never reallocated (reserved up front): index_ keys view the messages
+  std::vector<ErrorSketch::Counter> counters_;
+  std::vector<uint32_t> heap_;    // Counter indices, smallest count first
+  std::vector<uint32_t> heapPos_; // Position of each counter in heap_
+  std::unordered_map<std::string_view, uint32_t> index_;
+};
+
+} // namespace loganalyzer
@@ -0,0 +1,67 @@
+#include "ErrorSketch.h"
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace loganalyzer {
+
+uint64_t ErrorSketch::minCount() const {
+  // Until every counter is taken, all messages seen have one
+  if (counters.size() < capacity)
+    return 0;
+  uint64_t min = UINT64_MAX;
+  for (const Counter &counter : counters)
+    min = std::min(min, counter.count);
+  return counters.empty() ? 0 : min;
+}
+
+void ErrorSketch::merge(const ErrorSketch &other) {
+  if (other.capacity == 0)
+    return;
+  capacity = std::max(capacity, other.capacity);
+
+  // A message missing on one side may have occurred up to that side's
+  // minimum there: add it to count and error alike
+  const uint64_t mineMin = minCount();
+  const uint64_t theirMin = other.minCount();
+
+  std::unordered_map<std::string_view, const Counter *> theirs;
+  theirs.reserve(other.counters.size());
+  for (const Counter &counter : other.counters)
+    theirs.emplace(counter.message, &counter);
+
+  std::vector<Counter> merged;
+  merged.reserve(counters.size() + other.counters.size());
+  for (Counter &counter : counters) {
+    auto it = theirs.find(counter.message);
+    if (it != theirs.end()) {
+      counter.count += it->second->count;
+      counter.error += it->second->error;
+      theirs.erase(it);
+    } else {
+      counter.count += theirMin;
+      counter.error += theirMin;
+    }
+    merged.push_back(std::move(counter));
+  }
+  for (const Counter &counter : other.counters) {
+    if (theirs.count(counter.message)) {
+      merged.push_back({counter.message, counter.count + mineMin,
+                        counter.error + mineMin});
+    }
+  }
+
+  // Keep the largest counts; ties by message, so merges are repeatable
+  if (merged.size() > capacity) {
+    std::nth_element(merged.begin(), merged.begin() + capacity, merged.end(),
+                     [](const Counter &a, const Counter &b) {
+                       return a.count != b.count ? a.count > b.count
+                                                 : a.message < b.message;
+                     });
+    merged.resize(capacity);
+  }
+  counters = std::move(merged);
+}
+
+} // namespace loganalyzer
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Fixed-size summary of ERROR message counts (Space-Saving).
+ *
+ * Holds at most capacity counters. A counter's count never undercounts
+ * its message and overcounts it by at most its error, and any message
+ * without a counter occurred at most minCount() times. Summaries of
+ * different threads or files merge into one with the same guarantees
+ * (Agarwal et al., "Mergeable Summaries").
+ */
+struct ErrorSketch {
+  struct Counter {
+    std::string message;
+    uint64_t count = 0;
+    uint64_t error = 0; // True count lies in [count - error, count]
+  };
+
+  size_t capacity = 0; // 0 when not in use (exact mode)
+  std::vector<Counter> counters;
+
+  // Upper bound for the count of any message without a counter
+  uint64_t minCount() const;
+
+  void merge(const ErrorSketch &other);
+};
+
+} // namespace loganalyzer
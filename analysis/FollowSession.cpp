@@ -0,0 +1,102 @@
+#include "FollowSession.h"
+#include "../io/MemoryMappedFile.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <utility>
+
+namespace loganalyzer {
+
+namespace {
+
+// Prefix compared between updates to notice a rewritten file
+constexpr size_t kHeadBytes = 4096;
+
+uint64_t hashHead(std::string_view data, size_t size) {
+  return std::hash<std::string_view>{}(data.substr(0, size));
+}
+
+} // namespace
+
+FollowSession::FollowSession(std::string path, AnalysisContext context)
+    : path_(std::move(path)), context_(std::move(context)) {}
+
+FollowSession::Update FollowSession::update(ProgressCallback progressCallback,
+                                            bool *wasCancelled) {
+  if (wasCancelled) {
+    *wasCancelled = false;
+  }
+
+  struct stat sb;
+  MemoryMappedFile file(path_);
+  if (::stat(path_.c_str(), &sb) == -1 || !file.isOpen()) {
+    throw std::runtime_error("Cannot open file: " + path_);
+  }
+  std::string_view data = file.getView();
+
+  // Rotation replaces the file, truncation shrinks it: start over. A
+  // truncated file may have grown past offset_ again, so the first bytes
+  // and the line end at offset_ must still be the ones analyzed.
+  const bool restart = !started_ ||
+                       static_cast<uint64_t>(sb.st_dev) != device_ ||
+                       static_cast<uint64_t>(sb.st_ino) != inode_ ||
+                       data.size() < offset_ ||
+                       (offset_ > 0 && data[offset_ - 1] != '\n') ||
+                       hashHead(data, headSize_) != headHash_;
+  const uint64_t base = restart ? 0 : offset_;
+
+  // Complete lines only; a line still being written is left for later
+  std::string_view fresh = data.substr(base);
+  size_t lastNewline = fresh.rfind('\n');
+  fresh = lastNewline == std::string_view::npos
+              ? std::string_view()
+              : fresh.substr(0, lastNewline + 1);
+  if (fresh.empty() && !restart) {
+    return Update::Unchanged;
+  }
+
+  bool cancelled = false;
+  AnalysisResult delta = Pipeline::runBuffer(fresh, base, context_,
+                                             progressCallback, &cancelled);
+  if (cancelled) {
+    // Partial delta: drop it, the same bytes are analyzed next time
+    if (wasCancelled) {
+      *wasCancelled = true;
+    }
+    return Update::Unchanged;
+  }
+
+  if (restart) {
+    result_ = AnalysisResult{};
+    lines_ = 0;
+    headSize_ = 0;
+    started_ = true;
+    device_ = static_cast<uint64_t>(sb.st_dev);
+    inode_ = static_cast<uint64_t>(sb.st_ino);
+  }
+
+  // Sample line numbers count from the first new line
+  for (auto &[code, samples] : delta.errorSamples) {
+    for (auto &sample : samples) {
+      sample.lineNumber += lines_;
+    }
+  }
+
+  lines_ += delta.totalLines;
+
+  // Worker statistics describe the latest update only
+  result_.workerStats.clear();
+  result_.merge(std::move(delta));
+  result_.coalesceTimeline();
+  result_.selectTopErrors();
+
+  offset_ = base + fresh.size();
+  if (headSize_ < kHeadBytes) {
+    headSize_ = std::min<size_t>(offset_, kHeadBytes);
+    headHash_ = hashHead(data, headSize_);
+  }
+  return restart ? Update::Restarted : Update::Appended;
+}
+
+} // namespace loganalyzer
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "AnalysisContext.h"
+#include "AnalysisResult.h"
+#include "Pipeline.h"
+#include <cstdint>
+#include <string>
+
+namespace loganalyzer {
+
+/**
+ * @brief Incremental analysis of a log file that is still being written.
+ *
+ * Keeps the merged result and the offset just past the last complete line
+ * analyzed. Each update() maps the file again, analyzes only the complete
+ * lines appended since the previous call and merges them in, so a refresh
+ * costs in proportion to the new data. A truncated file, or a different
+ * file at the same path (log rotation), starts over from byte 0. So does
+ * a file whose first bytes changed, which catches a truncation that grew
+ * past the old size again between two updates.
+ *
+ * An unterminated last line waits until its newline is written. Error
+ * counts merge exactly, so top errors match a full analysis.
+ */
+class FollowSession {
+public:
+  enum class Update {
+    Unchanged, // Nothing new, or the update was cancelled
+    Appended,  // New lines merged into result()
+    Restarted  // File truncated or replaced; result() was rebuilt
+  };
+
+  FollowSession(std::string path, AnalysisContext context);
+
+  // Throws std::runtime_error if the file cannot be opened
+  Update update(ProgressCallback progressCallback = nullptr,
+                bool *wasCancelled = nullptr);
+
+  const AnalysisResult &result() const { return result_; }
+  const std::string &path() const { return path_; }
+
+  // Bytes and lines analyzed so far
+  uint64_t offset() const { return offset_; }
+  uint64_t lines() const { return lines_; }
+
+private:
+  std::string path_;
+  AnalysisContext context_;
+  AnalysisResult result_;
+
+  bool started_ = false;
+  uint64_t device_ = 0; // Identity of the file analyzed so far
+  uint64_t inode_ = 0;
+  uint64_t headHash_ = 0; // Hash of the first headSize_ bytes analyzed
+  size_t headSize_ = 0;
+  uint64_t offset_ = 0;
+  uint64_t lines_ = 0;
+};
+
+} // namespace loganalyzer
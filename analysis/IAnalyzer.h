@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../core/LogEntry.h"
+#include "../core/ParseFields.h"
 #include "AnalysisResult.h"
 #include <concepts>
 
@@ -15,6 +16,9 @@ public:
 
   // Finalize analysis and write results
   virtual void finalize(AnalysisResult &result) = 0;
+
+  // LogEntry fields process() reads; used to plan the parse
+  virtual ParseFields requiredFields() const { return ParseFields::all(); }
 };
 
 // C++20 Concept
@@ -5,12 +5,13 @@
 
 namespace loganalyzer {
 
-class KeywordHitAnalyzer : public IAnalyzer {
+class KeywordHitAnalyzer final : public IAnalyzer {
 public:
   explicit KeywordHitAnalyzer(const std::string &keyword);
 
   void process(const LogEntry &entry) override;
   void finalize(AnalysisResult &result) override;
+  ParseFields requiredFields() const override { return {false, false, true}; }
 
 private:
   std::string keyword_;
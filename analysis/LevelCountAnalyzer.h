@@ -5,10 +5,11 @@
 
 namespace loganalyzer {
 
-class LevelCountAnalyzer : public IAnalyzer {
+class LevelCountAnalyzer final : public IAnalyzer {
 public:
   void process(const LogEntry &entry) override;
   void finalize(AnalysisResult &result) override;
+  ParseFields requiredFields() const override { return {false, true, false}; }
 
 private:
   std::map<LogLevel, uint64_t> counts_;
@@ -1,29 +1,54 @@
 #include "Pipeline.h"
-#include "../core/PatternLogParser.h"
-#include "../core/StandardLogParser.h"
+#include "../core/FormatRegistry.h"
+#include "../io/Decompressor.h"
+#include "../io/InputPaths.h"
+#include "../io/LineScanner.h"
 #include "../io/MemoryMappedFile.h"
-#include "KeywordHitAnalyzer.h"
-#include "LevelCountAnalyzer.h"
+#include "../io/StreamReader.h"
+#include "QueryPlan.h"
+#include "ThreadPool.h"
 #include "TimeRangeFilter.h"
-#include "TopErrorAnalyzer.h"
 #include <algorithm>
-#include <cmath>
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <stdexcept>
-#include <sys/stat.h>
-#include <thread>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace loganalyzer {
 
 namespace {
 
-// Helper to determine chunk boundaries for parallel processing
-struct Chunk {
-  std::string_view data;
-  size_t startLineNumber;
-};
+// Lines handed out per LineScanner batch, parsed with one parseBatch call
+constexpr size_t kLineBatchSize = ParsedBatch::kCapacity;
+
+// Unit of scheduling. Small enough that idle workers can steal from a slow
+// region (e.g. a burst of long stack traces), large enough to keep queue
+// traffic negligible. Also the block size of streamed input.
+constexpr size_t kMorselSize = 4 * 1024 * 1024;
+
+// Windowed mapping: extra bytes mapped past a morsel for the line that
+// crosses its end; doubled while that line is longer
+constexpr size_t kWindowOverhang = 64 * 1024;
+
+// Smallest windowed morsel, however tight the memory budget
+constexpr size_t kMinWindowMorsel = 256 * 1024;
+
+// Streamed blocks in flight per worker: one being parsed, one queued
+constexpr size_t kStreamBlocksPerWorker = 2;
+
+// How often the progress callback runs while waiting for the workers
+constexpr std::chrono::milliseconds kProgressInterval{50};
 
 // Locate the start of the next line after offset
 size_t findNextLineStart(std::string_view data, size_t offset) {
@@ -35,322 +60,775 @@ size_t findNextLineStart(std::string_view data, size_t offset) {
   return pos + 1;
 }
 
-} // namespace
+// A line belongs to the morsel its first byte falls in. Boundaries are
+// aligned by the worker that takes the morsel, not up front.
+size_t alignToLineStart(std::string_view data, size_t offset) {
+  return offset == 0 ? 0 : findNextLineStart(data, offset - 1);
+}
 
-AnalysisResult Pipeline::run(const std::string &inputPath,
-                             const AnalysisContext &context,
-                             ProgressCallback progressCallback,
-                             bool *wasCancelled) {
+// Everything one pool worker accumulates over the chunks it runs
+struct WorkerState {
+  bool initialized = false;
   AnalysisResult result;
+  std::unique_ptr<ILogParser> parser;
+  QueryPlan::AnalyzerSets analyzers;
+  std::map<int64_t, std::pair<uint32_t, uint32_t>>
+      timeline; // Minute start -> {Error, Warning}
+  ParsedBatch parsed;
 
-  if (wasCancelled) {
-    *wasCancelled = false;
-  }
+  AnalysisResult::WorkerStats stats;
+};
 
-  // Open file with Memory Mapping
-  MemoryMappedFile mmapFile(inputPath);
-  if (!mmapFile.isOpen()) {
-    return result;
+// Counts for one morsel or stream block. Error samples get line numbers
+// relative to their chunk; the prefix sum over all chunks of a file makes
+// them absolute without a serial pre-pass.
+struct ChunkStats {
+  uint64_t begin = 0; // Run offset at or before the chunk's first line
+  uint32_t file = 0;
+  uint64_t lines = 0;
+  uint64_t parsed = 0;
+  uint64_t invalid = 0;
+};
+
+// The inputs of one run. All files share one offset space (each starts
+// where the previous one ends), so morsels of every file are scheduled
+// together and sample offsets stay unique.
+struct RunLayout {
+  std::vector<ChunkStats> chunks; // In input order
+  std::vector<AnalysisResult::FileSummary> files;
+  std::vector<uint64_t> fileBases; // Run offset of each file's first byte
+};
+
+// A mapped file, or part of one, and where it sits in the run
+struct MappedInput {
+  std::string_view data;
+  uint64_t base = 0; // Run offset of data[0]
+  uint32_t file = 0;
+  // The whole mapping behind data, for readahead hints; null for buffers
+  // that are not a file mapping of their own
+  const MemoryMappedFile *mapping = nullptr;
+  // Set instead of data for a file opened windowed: each morsel maps its
+  // own window
+  const MemoryMappedFile *windowed = nullptr;
+
+  uint64_t size() const { return windowed ? windowed->size() : data.size(); }
+};
+
+MemoryMappedFile::Options mapOptions(const AnalysisContext &context) {
+  MemoryMappedFile::Options options;
+  options.access = context.mapReadahead ? MemoryMappedFile::Access::Sequential
+                                        : MemoryMappedFile::Access::Normal;
+  options.populate = context.mapPopulate;
+  options.hugePages = context.mapHugePages;
+  options.windowed = context.mapBudget > 0;
+  return options;
+}
+
+// Morsel size that keeps every worker's window inside the budget
+size_t morselSizeFor(const AnalysisContext &context, unsigned workers) {
+  if (context.mapBudget == 0)
+    return kMorselSize;
+  const uint64_t share = context.mapBudget / std::max(workers, 1u);
+  const uint64_t morsel = share > kWindowOverhang ? share - kWindowOverhang : 0;
+  return static_cast<size_t>(
+      std::clamp<uint64_t>(morsel, kMinWindowMorsel, kMorselSize));
+}
+
+/**
+ * @brief State shared by the workers of one Pipeline::run.
+ *
+ * The input-specific part (mmap morsels or streamed blocks) only decides
+ * which bytes each job hands to processLines(); parsing, analysis,
+ * cancellation, completion and merging are the same for both.
+ */
+class PipelineRun {
+public:
+  // Runs on one pool worker; receives that worker's state
+  using Job = std::function<void(WorkerState &)>;
+
+  PipelineRun(const AnalysisContext &context, ThreadPool &pool)
+      : context_(context), plan_(QueryPlan::build(context)),
+        filter_(context.fromTs, context.toTs), pool_(pool),
+        workers_(pool.size()) {}
+
+  unsigned workerCount() const { return pool_.size(); }
+
+  // Set when the progress callback asks to cancel. Workers also watch the
+  // caller's token, so a GUI cancel does not wait for the next callback.
+  bool shouldStop() const {
+    return stopRequested_.load(std::memory_order_relaxed) ||
+           (context_.stopToken &&
+            context_.stopToken->load(std::memory_order_relaxed));
   }
 
-  std::string_view fileData = mmapFile.getView();
-  if (fileData.empty()) {
-    return result;
+  uint64_t bytesProcessed() const {
+    return bytesProcessed_.load(std::memory_order_relaxed);
   }
 
-  // Determine available concurrency
-  unsigned int numThreads = std::thread::hardware_concurrency();
-  if (numThreads == 0)
-    numThreads = 2; // Fallback
+  // Process a buffer of complete lines starting at run offset base and
+  // record the counts (up to any cancel) in chunk
+  void processLines(WorkerState &state, std::string_view data, uint64_t base,
+                    ChunkStats &chunk);
+
+  // Run the jobs on the pool and wait for all of them, calling
+  // progressCallback with progress() every kProgressInterval.
+  // Returns true if the run was cancelled.
+  template <typename Progress>
+  bool execute(std::vector<Job> jobs, const ProgressCallback &progressCallback,
+               Progress progress);
+
+  // Merge the worker results and resolve samples to file and line
+  AnalysisResult finish(const RunLayout &layout);
+
+private:
+  WorkerState &initWorker(unsigned index);
+
+  // processLines() for the worker's analyzer set, resolved once per chunk
+  template <typename Analyzers>
+  void processLines(WorkerState &state, Analyzers &analyzers,
+                    std::string_view data, uint64_t base, ChunkStats &chunk);
+
+  const AnalysisContext &context_;
+  const QueryPlan plan_;
+  const TimeRangeFilter filter_;
+  ThreadPool &pool_;
+  std::vector<WorkerState> workers_;
+
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<uint64_t> bytesProcessed_{0};
+
+  // First exception thrown by a job, rethrown once all have finished
+  std::mutex errorMutex_;
+  std::exception_ptr firstError_;
+};
 
-  // For small files, avoid overhead of threads
-  if (fileData.size() < 1024 * 1024) { // < 1MB
-    numThreads = 1;
+WorkerState &PipelineRun::initWorker(unsigned index) {
+  WorkerState &state = workers_[index];
+  if (!state.initialized) {
+    // Setup parser (compile-time specialized if the pattern is registered)
+    // and analyzers, once per worker
+    state.parser = FormatRegistry::createParser(context_.customPattern);
+    state.parser->setFields(plan_.fields);
+    state.analyzers = QueryPlan::makeAnalyzerSet(context_);
+    state.initialized = true;
   }
+  return state;
+}
 
-  // Calculate chunks
-  std::vector<size_t> chunkStarts;
-  chunkStarts.push_back(0);
+void PipelineRun::processLines(WorkerState &state, std::string_view data,
+                               uint64_t base, ChunkStats &chunk) {
+  std::visit(
+      [&](auto &analyzers) {
+        processLines(state, analyzers, data, base, chunk);
+      },
+      state.analyzers);
+}
 
-  size_t idealChunkSize = fileData.size() / numThreads;
-  for (unsigned int i = 1; i < numThreads; ++i) {
-    size_t approximateStart = i * idealChunkSize;
-    size_t actualStart = findNextLineStart(fileData, approximateStart);
-    if (actualStart < fileData.size() && actualStart > chunkStarts.back()) {
-      chunkStarts.push_back(actualStart);
-    }
-  }
-  chunkStarts.push_back(fileData.size());
-
-  // Adjust numThreads if file was small or lines were huge
-  numThreads = chunkStarts.size() - 1;
-
-  // Shared progress tracker
-  std::atomic<uint64_t> totalBytesProcessed{0};
-  uint64_t fileSize = fileData.size();
-
-  // Define worker task
-  auto worker = [&](size_t startOffset, size_t endOffset,
-                    size_t startLineNum) -> AnalysisResult {
-    AnalysisResult localResult;
-
-    // Setup analyzers (thread-local instances)
-    TimeRangeFilter filter(context.fromTs, context.toTs);
-    std::vector<std::unique_ptr<IAnalyzer>> analyzers;
-    analyzers.push_back(std::make_unique<LevelCountAnalyzer>());
-    analyzers.push_back(
-        std::make_unique<TopErrorAnalyzer>()); // Each thread has its own top-N
-                                               // buffer
-    if (context.keyword.has_value()) {
-      analyzers.push_back(
-          std::make_unique<KeywordHitAnalyzer>(context.keyword.value()));
+template <typename Analyzers>
+void PipelineRun::processLines(WorkerState &state, Analyzers &analyzers,
+                               std::string_view data, uint64_t base,
+                               ChunkStats &chunk) {
+  AnalysisResult &localResult = state.result;
+  const uint64_t parsedBefore = localResult.parsedLines;
+  const uint64_t invalidBefore = localResult.invalidLines;
+  ILogParser &parser = *state.parser;
+  ParsedBatch &parsed = state.parsed;
+
+  LineScanner scanner(data);
+  LineSpan spans[kLineBatchSize];
+  std::string_view lines[kLineBatchSize];
+  size_t batchSize;
+  size_t scannedBytes = 0;
+  uint64_t linesBefore = 0; // Lines of this chunk in earlier batches
+
+  state.stats.morsels++;
+  state.stats.bytes += data.size();
+
+  while ((batchSize = scanner.nextBatch(spans, kLineBatchSize)) > 0) {
+    if (shouldStop())
+      break;
+
+    for (size_t i = 0; i < batchSize; ++i) {
+      size_t lineStart = spans[i].begin;
+      size_t contentEnd = spans[i].end;
+      if (contentEnd > lineStart && data[contentEnd - 1] == '\r') {
+        contentEnd--;
+      }
+      lines[i] = data.substr(lineStart, contentEnd - lineStart);
     }
 
-    size_t currentPos = startOffset;
-    size_t lineNumber = startLineNum; // Note: Line numbers will be estimates if
-                                      // we don't count previous newlines.
-    // Calculating exact line numbers for chunks requires counting newlines in
-    // previous chunks, which is linear. For accurate line numbers in results
-    // (e.g. error reporting), we might need two passes or just accept that line
-    // numbers are relative or approximate in this phase. However, usually we
-    // can just scan for newlines. To strictly follow requirements avoiding
-    // "double copy", counting newlines is fast. But parallel counting is
-    // complex. Let's assume for this "High Performance" version, exact line
-    // numbers for *every* line might be secondary OR we just count locally and
-    // don't care about global offset unless requested. Wait, ParseResult
-    // contains lineNumber. LogEntry works better with it. If we want exact line
-    // numbers, we must count newlines from 0 to startOffset. This kills
-    // parallelism if we do it sequentially. Compromise: We can just use local
-    // line number 0-based within chunk, or if strictness is needed, pre-scan
-    // newlines? Actually, for "Top Errors" we just need the message. Line
-    // number is used for ParseError reporting. Let's pass 0 or a placeholder if
-    // expensive, BUT user might want to locate errors. Let's accept that for
-    // now we pass relative line numbers or pseudo-numbers. OR better: we can
-    // guess line number = startOffset / avg_line_len? No, inaccurate. Correct
-    // approach for parallel lines:
-    // 1. Just process.
-    // 2. If we need global line numbers, we need a prefix sum of newline
-    // counts. Let's proceed with local line numbers for now or just
-    // startLineNum passed in. Wait, I can pass a startLineNum if I computed it.
-    // I won't compute it for speed. I'll just increment.
-
-    // Update: Since I don't pre-calculate line numbers, I'll start at 0 for
-    // each chunk basically? Or 1 + offset/something. Let's just use 0 as base
-    // for chunks > 0 to indicate "unknown absolute line". Users typically grep
-    // based on timestamp/content anyway.
-
-    const uint64_t progressReportInterval = 1024 * 1024; // 1MB
-    uint64_t bytesSinceLastReport = 0;
-
-    // Thread-local timeline aggregator
-    std::map<uint64_t, std::pair<uint32_t, uint32_t>>
-        localTimeline; // Key -> {Error, Warning}
-
-    // Setup parser
-    std::unique_ptr<ILogParser> parser;
-    if (!context.customPattern.empty()) {
-      parser = std::make_unique<PatternLogParser>(context.customPattern);
-    } else {
-      parser = std::make_unique<StandardLogParser>();
-    }
+    // Parse the whole block with one virtual call
+    parser.parseBatch(std::span(lines, batchSize), parsed);
+    localResult.totalLines += batchSize;
 
-    while (currentPos < endOffset) {
-      if (wasCancelled && *wasCancelled)
-        return localResult;
+    for (size_t i = 0; i < batchSize; ++i) {
+      if (!parsed.valid[i]) {
+        localResult.invalidLines++;
+        ParseErrorCode code = parsed.errors[i];
+        localResult.parseErrors[code]++;
+        // Chunk-relative line number, fixed up in finish()
+        localResult.addErrorSample(
+            code, base + static_cast<uint64_t>(lines[i].data() - data.data()),
+            linesBefore + i + 1, lines[i]);
+        continue;
+      }
 
-      size_t newlinePos = fileData.find('\n', currentPos);
-      size_t lineEnd =
-          (newlinePos == std::string_view::npos || newlinePos >= endOffset)
-              ? endOffset
-              : newlinePos;
+      localResult.parsedLines++; // thread-local count
+      const Timestamp &ts = parsed.timestamps[i];
+      if (!filter_.accept(ts))
+        continue;
 
-      size_t contentEnd = lineEnd;
-      if (contentEnd > currentPos && fileData[contentEnd - 1] == '\r') {
-        contentEnd--;
+      if (filter_.isActive())
+        localResult.timeRangeMatched++;
+      if (!analyzers.empty()) {
+        analyzers.process(parsed.entry(i, lines[i]));
       }
 
-      std::string_view line =
-          fileData.substr(currentPos, contentEnd - currentPos);
-      lineNumber++;
+      // --- Populate Heatmap & Timeline ---
+      if (plan_.timeline && ts.isValid()) {
+        localResult.heatmap[ts.dayOfWeek()][ts.hourOfDay()]++;
 
-      // Parse
-      ParseResult parseResult = parser->parse(line, lineNumber);
+        // Timeline: Bucket by minute
+        int64_t timeKey = ts.minuteBucket();
 
-      if (std::holds_alternative<LogEntry>(parseResult)) {
-        localResult.parsedLines++; // thread-local count
-        const LogEntry &entry = std::get<LogEntry>(parseResult);
+        LogLevel level = parsed.levels[i];
+        if (level == LogLevel::ERROR) {
+          state.timeline[timeKey].first++;
+        } else if (level == LogLevel::WARNING) {
+          state.timeline[timeKey].second++;
+        }
+      }
+    }
 
-        if (filter.accept(entry.ts)) {
-          if (filter.isActive())
-            localResult.timeRangeMatched++;
-          for (auto &analyzer : analyzers) {
-            analyzer->process(entry);
-          }
+    // Progress
+    size_t consumed = scanner.position() - scannedBytes;
+    scannedBytes = scanner.position();
+    bytesProcessed_.fetch_add(consumed, std::memory_order_relaxed);
+    linesBefore += batchSize;
+  }
 
-          // --- Populate Heatmap & Timeline ---
-          if (entry.ts.month > 0) { // Valid check heuristic
-            // Calculate day of week (0=Sunday)
-            // Zeller's congruence or just std::tm if we reused it?
-            // Optimization: We manually parsed ts, so we don't have tm
-            // directly. Let's rely on a helper or basic calculation. For speed,
-            // C++20 chrono is best but we are C++17 here (mostly). Let's do a
-            // simple Zeller for Day of Week. Zeller algorithm (0=Saturday,
-            // 1=Sunday.. for the math, adjusted to 0=Sun):
-            int y = entry.ts.year;
-            int m = entry.ts.month;
-            int q = entry.ts.day;
-            if (m < 3) {
-              m += 12;
-              y -= 1;
-            }
-            int K = y % 100;
-            int J = y / 100;
-            int h = (q + 13 * (m + 1) / 5 + K + K / 4 + J / 4 + 5 * J) % 7;
-            // h is 0=Saturday, 1=Sunday...6=Friday
-            // Map to 0=Sunday...6=Saturday
-            int dayIdx = (h + 1) % 7; // Now 0=Sun, 1=Mon...6=Sat
-
-            int hourIdx = entry.ts.hour;
-            if (dayIdx >= 0 && dayIdx < 7 && hourIdx >= 0 && hourIdx < 24) {
-              localResult.heatmap[dayIdx][hourIdx]++;
-            }
-
-            // Timeline: Bucket by minute
-            // We need a monotonic timestamp.
-            // Let's assume entry.ts can convert to unix time approx or we just
-            // use the raw components. Let's use a simplified 64-bit sort key:
-            // YYYYMMDDHHMM This is sufficient for sorting and buckets.
-            uint64_t timeKey = (uint64_t)entry.ts.year * 100000000 +
-                               (uint64_t)entry.ts.month * 1000000 +
-                               (uint64_t)entry.ts.day * 10000 +
-                               (uint64_t)entry.ts.hour * 100 +
-                               (uint64_t)entry.ts.minute;
-
-            if (entry.level == LogLevel::ERROR) {
-              localTimeline[timeKey].first++;
-            } else if (entry.level == LogLevel::WARNING) {
-              localTimeline[timeKey].second++;
-            }
-          }
+  chunk.lines = linesBefore;
+  chunk.parsed = localResult.parsedLines - parsedBefore;
+  chunk.invalid = localResult.invalidLines - invalidBefore;
+}
+
+template <typename Progress>
+bool PipelineRun::execute(std::vector<Job> jobs,
+                          const ProgressCallback &progressCallback,
+                          Progress progress) {
+  // The last job to finish wakes the caller
+  size_t remaining = jobs.size(); // Guarded by doneMutex
+  std::mutex doneMutex;
+  std::condition_variable doneCv;
+
+  std::vector<ThreadPool::Task> tasks;
+  tasks.reserve(jobs.size());
+  for (auto &job : jobs) {
+    tasks.push_back([&, job = std::move(job)](unsigned workerIndex) {
+      // After a cancel the remaining jobs only count down
+      if (!shouldStop()) {
+        auto started = std::chrono::steady_clock::now();
+        try {
+          job(initWorker(workerIndex));
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(errorMutex_);
+          if (!firstError_)
+            firstError_ = std::current_exception();
         }
-      } else {
-        localResult.invalidLines++;
-        const ParseError &error = std::get<ParseError>(parseResult);
-        localResult.parseErrors[error.code]++;
+
+        std::chrono::duration<double> busy =
+            std::chrono::steady_clock::now() - started;
+        workers_[workerIndex].stats.busySeconds += busy.count();
       }
 
-      localResult.totalLines++;
+      // Count down under the lock: the caller may return, destroying
+      // doneMutex and doneCv, as soon as it sees remaining == 0
+      std::lock_guard<std::mutex> lock(doneMutex);
+      if (--remaining == 0)
+        doneCv.notify_one();
+    });
+  }
+  pool_.submit(std::move(tasks));
+
+  // Wait for the jobs, reporting progress in between. Jobs reference this
+  // stack frame, so even after a cancel we wait for all of them (they
+  // return early).
+  std::unique_lock<std::mutex> lock(doneMutex);
+  auto allDone = [&] { return remaining == 0; };
+  while (!doneCv.wait_for(lock, kProgressInterval, allDone)) {
+    if (!progressCallback || stopRequested_.load(std::memory_order_relaxed))
+      continue;
+
+    lock.unlock();
+    if (!progressCallback(progress()))
+      stopRequested_.store(true, std::memory_order_relaxed);
+    lock.lock();
+  }
+  lock.unlock();
 
-      // Progress
-      size_t consumed = (lineEnd - currentPos) +
-                        (newlinePos != std::string_view::npos ? 1 : 0);
-      currentPos += consumed;
+  if (firstError_) {
+    std::rethrow_exception(firstError_);
+  }
+  return shouldStop();
+}
 
-      bytesSinceLastReport += consumed;
-      if (bytesSinceLastReport >= progressReportInterval) {
-        totalBytesProcessed.fetch_add(bytesSinceLastReport,
-                                      std::memory_order_relaxed);
-        bytesSinceLastReport = 0;
-      }
+AnalysisResult PipelineRun::finish(const RunLayout &layout) {
+  AnalysisResult result;
+  const std::vector<ChunkStats> &chunks = layout.chunks;
 
-      if (currentPos >= endOffset && newlinePos == std::string_view::npos)
-        break;
-    }
+  // Gather results
+  for (WorkerState &state : workers_) {
+    if (!state.initialized)
+      continue;
 
-    // Flush remaining progress
-    if (bytesSinceLastReport > 0) {
-      totalBytesProcessed.fetch_add(bytesSinceLastReport,
-                                    std::memory_order_relaxed);
-    }
+    ParserStats parserStats = state.parser->stats();
+    state.result.timestampCacheHits = parserStats.timestampCacheHits;
+    state.result.timestampCacheMisses = parserStats.timestampCacheMisses;
 
     // Finalize analyzers
-    for (auto &analyzer : analyzers) {
-      analyzer->finalize(localResult);
-    }
+    std::visit([&](auto &analyzers) { analyzers.finalize(state.result); },
+               state.analyzers);
 
     // Flatten timeline map to vector
-    localResult.timeline.reserve(localTimeline.size());
-    for (const auto &[timeKey, counts] : localTimeline) {
-      localResult.timeline.push_back({timeKey, counts.first, counts.second});
+    state.result.timeline.reserve(state.timeline.size());
+    for (const auto &[timeKey, counts] : state.timeline) {
+      state.result.timeline.push_back({timeKey, counts.first, counts.second});
     }
 
-    return localResult;
+    result.merge(std::move(state.result));
+  }
+  result.coalesceTimeline();
+  result.selectTopErrors();
+
+  // Per-file counts, and the line number each chunk starts at in its file
+  result.files = layout.files;
+  std::vector<uint64_t> firstLine(chunks.size(), 0);
+  for (size_t c = 0; c < chunks.size(); ++c) {
+    if (c > 0 && chunks[c].file == chunks[c - 1].file)
+      firstLine[c] = firstLine[c - 1] + chunks[c - 1].lines;
+    if (chunks[c].file < result.files.size()) {
+      AnalysisResult::FileSummary &file = result.files[chunks[c].file];
+      file.totalLines += chunks[c].lines;
+      file.parsedLines += chunks[c].parsed;
+      file.invalidLines += chunks[c].invalid;
+    }
+  }
+
+  // Turn run offsets and chunk-relative line numbers into file positions.
+  // A sample belongs to the last chunk starting at or before its offset.
+  auto startsAfter = [](uint64_t offset, const ChunkStats &chunk) {
+    return offset < chunk.begin;
   };
+  for (auto &[code, samples] : result.errorSamples) {
+    for (auto &sample : samples) {
+      auto it = std::upper_bound(chunks.begin(), chunks.end(), sample.offset,
+                                 startsAfter);
+      if (it == chunks.begin())
+        continue;
+      const size_t c = (it - chunks.begin()) - 1;
+      sample.lineNumber += firstLine[c];
+      sample.file = chunks[c].file;
+      if (sample.file < layout.fileBases.size())
+        sample.offset -= layout.fileBases[sample.file];
+    }
+  }
 
-  // Launch tasks
-  std::vector<std::future<AnalysisResult>> futures;
-  for (unsigned int i = 0; i < numThreads; ++i) {
-    size_t start = chunkStarts[i];
-    size_t end = chunkStarts[i + 1];
-    // Note: We are ignoring absolute line numbers for performance in Phase 2.
-    futures.push_back(std::async(std::launch::async, worker, start, end, 0));
-  }
-
-  // Monitor progress while waiting
-  if (numThreads > 0) {
-    // We can't easily wait_for on all futures in a loop without blocking logic.
-    // Simpler: Just wait for all, but maybe use a dedicated progress thread?
-    // Or just check futures one by one?
-    // Check futures one by one is simple but sequential.
-    // Better: Main loop sleeps and checks atomic counter.
-    // But we need to know when tasks are done.
-    // Workaround: We loop until totalBytesProcessed >= fileSize or close
-    // enough, OR we assume futures return. But std::async destructors block.
-    // Let's loop checking status? No standard is_ready without wait_for(0).
-
-    bool allDone = false;
-    while (!allDone) {
-      if (wasCancelled && *wasCancelled)
-        break;
-
-      // Create a small delay
-      std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-      // Report progress
-      if (progressCallback && fileSize > 0) {
-        float p = static_cast<float>(
-                      totalBytesProcessed.load(std::memory_order_relaxed)) /
-                  static_cast<float>(fileSize);
-        if (!progressCallback(p)) {
-          if (wasCancelled)
-            *wasCancelled = true;
-          break;
-        }
+  // Busy time of every pool worker, including idle ones
+  for (unsigned i = 0; i < workers_.size(); ++i) {
+    AnalysisResult::WorkerStats stats = workers_[i].stats;
+    stats.worker = i;
+    result.workerStats.push_back(stats);
+  }
+  return result;
+}
+
+// Lines starting in [begin, end) of a file opened windowed. Maps from the
+// byte before begin (a line starts at begin if it is '\n') to past end,
+// far enough to finish the last line, then unmaps and evicts the morsel.
+void processWindow(PipelineRun &run, WorkerState &state,
+                   const MemoryMappedFile &file, uint64_t base, size_t begin,
+                   size_t end, ChunkStats &chunk) {
+  const size_t size = file.size();
+  const size_t from = begin > 0 ? begin - 1 : 0;
+  size_t overhang = kWindowOverhang;
+
+  while (true) {
+    MemoryMappedFile::Window window =
+        file.map(from, std::min(size, end + overhang) - from);
+    std::string_view view = window.view();
+    if (view.empty()) {
+      throw std::runtime_error("Cannot map file window");
+    }
+
+    const size_t start = alignToLineStart(view, begin - from);
+    if (start >= end - from)
+      break; // Inside one line that started in an earlier morsel
+    const size_t stop =
+        end == size ? view.size() : alignToLineStart(view, end - from);
+    if (stop == view.size() && from + view.size() < size) {
+      overhang *= 2; // The last line runs past the window
+      continue;
+    }
+    run.processLines(state, view.substr(start, stop - start),
+                     base + from + start, chunk);
+    break;
+  }
+  file.evict(begin, end - begin);
+}
+
+// Memory-mapped files: fixed-size morsels, aligned to lines by the worker
+// that takes them. Morsels of all files go to the pool as one group, so
+// many small files keep every worker busy.
+bool runMapped(PipelineRun &run, const std::vector<MappedInput> &inputs,
+               size_t morselSize, const ProgressCallback &progressCallback,
+               std::vector<ChunkStats> &chunks) {
+  std::vector<PipelineRun::Job> jobs;
+  uint64_t totalSize = 0;
+  for (const MappedInput &input : inputs) {
+    const size_t inputSize = input.size();
+    for (size_t m = 0; m * morselSize < inputSize; ++m) {
+      const size_t chunk = chunks.size();
+      const size_t begin = m * morselSize;
+      const size_t end = std::min(begin + morselSize, inputSize);
+      chunks.push_back({input.base + begin, input.file});
+
+      if (input.windowed) {
+        jobs.push_back([&run, &chunks, file = input.windowed,
+                        base = input.base, begin, end,
+                        chunk](WorkerState &state) {
+          processWindow(run, state, *file, base, begin, end, chunks[chunk]);
+        });
+        continue;
       }
 
-      // Check if completion (heuristic or check futures)
-      // Ideally we used a latch or barrier, but C++17 doesn't have it
-      // standardly (C++20 does). We can check wait_for(0) on all futures.
-      allDone = true;
-      for (auto &f : futures) {
-        if (f.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
-          allDone = false;
-          break;
+      jobs.push_back([&run, &chunks, fileData = input.data,
+                      base = input.base, begin, end, chunk,
+                      mapping = input.mapping](WorkerState &state) {
+        // Process the lines starting in the morsel
+        size_t start = alignToLineStart(fileData, begin);
+        size_t stop = alignToLineStart(fileData, end);
+        // Let the kernel read the next morsel while this one is parsed;
+        // whoever takes it will likely find it in memory
+        if (mapping)
+          mapping->willNeed(stop, end - begin);
+        if (start < stop) {
+          run.processLines(state, fileData.substr(start, stop - start),
+                           base + start, chunks[chunk]);
         }
-      }
+        // Done with these pages; keeps the resident set small
+        if (mapping)
+          mapping->dontNeed(start, stop - start);
+      });
     }
+    totalSize += inputSize;
   }
 
-  // Gather results
-  for (auto &f : futures) {
-    if (f.valid()) { // if not moved
-      // If cancelled, we still want to join basically?
-      // If cancelled, futures will complete eventually.
-      try {
-        AnalysisResult part = f.get();
-        result.merge(part);
-      } catch (...) {
-        // Ignore exceptions from threads? Or rethrow?
+  // Empty files only: nothing to report until the end
+  const float total = static_cast<float>(totalSize);
+  return run.execute(std::move(jobs), progressCallback, [&] {
+    return totalSize > 0 ? static_cast<float>(run.bytesProcessed()) / total
+                         : 0.0f;
+  });
+}
+
+// Streamed input: the StreamReader thread fills line-aligned blocks while
+// every worker takes blocks until the input ends. totalBytes is 0 when the
+// size is not known up front.
+bool runStreamed(PipelineRun &run, StreamReader &reader, uint64_t totalBytes,
+                 const ProgressCallback &progressCallback,
+                 std::vector<ChunkStats> &chunks) {
+  std::mutex chunksMutex;
+  std::vector<bool> ran; // Blocks complete out of order, or not at all
+
+  std::vector<PipelineRun::Job> jobs;
+  for (unsigned w = 0; w < run.workerCount(); ++w) {
+    jobs.push_back([&](WorkerState &state) {
+      StreamReader::Block *block;
+      while (!run.shouldStop() && (block = reader.next()) != nullptr) {
+        ChunkStats chunk{block->offset, 0};
+        run.processLines(state, block->view(), block->offset, chunk);
+        {
+          std::lock_guard<std::mutex> lock(chunksMutex);
+          if (chunks.size() <= block->index) {
+            chunks.resize(block->index + 1);
+            ran.resize(block->index + 1);
+          }
+          chunks[block->index] = chunk;
+          ran[block->index] = true;
+        }
+        reader.release(block);
       }
-    }
+    });
+  }
+
+  // Without a known size, progress stays at 0 until the end
+  const float total = static_cast<float>(totalBytes);
+  bool cancelled = false;
+  try {
+    cancelled = run.execute(std::move(jobs), progressCallback, [&] {
+      return totalBytes > 0 ? std::min(1.0f, run.bytesProcessed() / total)
+                            : 0.0f;
+    });
+  } catch (...) {
+    reader.stop();
+    throw;
+  }
+  reader.stop();
+
+  // After a cancel, blocks before the last one taken may never have run;
+  // finish() needs the chunks in offset order without those gaps
+  size_t kept = 0;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    if (ran[i])
+      chunks[kept++] = chunks[i];
+  }
+  chunks.resize(kept);
+
+  if (reader.failed()) {
+    throw std::runtime_error("Failed to read input stream: " +
+                             reader.error());
   }
+  return cancelled;
+}
+
+// Set up the pool and the shared run state, let drive() schedule the
+// input, then merge. drive(run, layout) fills layout.chunks and returns
+// true if cancelled.
+template <typename Drive>
+AnalysisResult analyze(const AnalysisContext &context,
+                       const ProgressCallback &progressCallback,
+                       bool *wasCancelled, RunLayout layout, Drive drive) {
+  // An explicit thread count gets a private pool for this run
+  std::unique_ptr<ThreadPool> privatePool;
+  if (context.threads > 0) {
+    privatePool = std::make_unique<ThreadPool>(context.threads);
+  }
+  ThreadPool &pool = privatePool ? *privatePool : ThreadPool::instance();
+
+  PipelineRun run(context, pool);
+  const bool cancelled = drive(run, layout);
+
+  if (wasCancelled) {
+    *wasCancelled = cancelled;
+  }
+
+  AnalysisResult result = run.finish(layout);
 
   // Final progress 100%
-  if (progressCallback && (!wasCancelled || !*wasCancelled)) {
+  if (progressCallback && !cancelled) {
     progressCallback(1.0f);
   }
 
   return result;
 }
 
+// Files that go through a StreamReader instead of being mapped
+bool isStreamed(const std::string &path, const AnalysisContext &context) {
+  return context.io == IoBackend::Pread || StreamReader::needsStreaming(path);
+}
+
+// Size of the text a StreamReader will deliver for path, if known up front:
+// uncompressed regular files only
+uint64_t knownStreamSize(const std::string &path) {
+  if (StreamReader::isStreamPath(path) ||
+      Decompressor::detectFile(path) != Compression::None)
+    return 0;
+  std::error_code error;
+  const uintmax_t size = std::filesystem::file_size(path, error);
+  return error ? 0 : static_cast<uint64_t>(size);
+}
+
+// Analyze mapped files (paths[i] mapped as files[i]) as one run
+AnalysisResult analyzeFiles(const std::vector<std::string> &paths,
+                            const std::vector<MemoryMappedFile> &files,
+                            const AnalysisContext &context,
+                            const ProgressCallback &progressCallback,
+                            bool *wasCancelled) {
+  RunLayout layout;
+  std::vector<MappedInput> inputs;
+  uint64_t base = 0;
+
+  for (size_t i = 0; i < paths.size(); ++i) {
+    MappedInput input{files[i].getView(), base, static_cast<uint32_t>(i)};
+    if (context.mapBudget > 0) {
+      input.windowed = &files[i];
+    } else if (context.mapReadahead) {
+      input.mapping = &files[i];
+    }
+    layout.files.push_back({paths[i], input.size()});
+    layout.fileBases.push_back(base);
+    base += input.size();
+    inputs.push_back(input);
+  }
+
+  return analyze(context, progressCallback, wasCancelled, std::move(layout),
+                 [&](PipelineRun &run, RunLayout &layout) {
+                   return runMapped(
+                       run, inputs, morselSizeFor(context, run.workerCount()),
+                       progressCallback, layout.chunks);
+                 });
+}
+
+} // namespace
+
+AnalysisResult Pipeline::run(const std::string &inputPath,
+                             const AnalysisContext &context,
+                             ProgressCallback progressCallback,
+                             bool *wasCancelled) {
+  if (wasCancelled) {
+    *wasCancelled = false;
+  }
+
+  // Pipes, stdin and compressed files cannot be split into morsels; with
+  // the pread backend nothing is mapped
+  if (isStreamed(inputPath, context)) {
+    RunLayout layout;
+    layout.files.push_back({inputPath});
+    return analyze(
+        context, progressCallback, wasCancelled, std::move(layout),
+        [&](PipelineRun &run, RunLayout &layout) {
+          // Bounded: a few blocks per worker, refilled as they are
+          // released. Parallel gzip members are inflated on as many threads
+          // as there are workers; those wait for blocks meanwhile.
+          StreamReader reader(inputPath, kMorselSize,
+                              run.workerCount() * kStreamBlocksPerWorker,
+                              run.workerCount());
+          if (!reader.isOpen()) {
+            throw std::runtime_error("Cannot open input stream: " +
+                                     inputPath);
+          }
+          bool cancelled = runStreamed(run, reader, knownStreamSize(inputPath),
+                                       progressCallback, layout.chunks);
+          layout.files.front().bytes = run.bytesProcessed();
+          return cancelled;
+        });
+  }
+
+  // Open file with Memory Mapping
+  std::vector<MemoryMappedFile> files;
+  files.emplace_back(inputPath, mapOptions(context));
+  if (!files.front().isOpen()) {
+    return AnalysisResult{};
+  }
+  return analyzeFiles({inputPath}, files, context, progressCallback,
+                      wasCancelled);
+}
+
+AnalysisResult Pipeline::run(const std::vector<std::string> &inputPaths,
+                             const AnalysisContext &context,
+                             ProgressCallback progressCallback,
+                             bool *wasCancelled) {
+  if (inputPaths.empty()) {
+    throw std::runtime_error("No input files");
+  }
+
+  // A file named twice, in any spelling, is analyzed once at its first
+  // position
+  const std::vector<std::string> paths = InputPaths::unique(inputPaths);
+  if (paths.size() == 1) {
+    return run(paths.front(), context, progressCallback, wasCancelled);
+  }
+  if (wasCancelled) {
+    *wasCancelled = false;
+  }
+
+  std::vector<std::string> mappedPaths;
+  std::vector<MemoryMappedFile> files;
+  std::vector<std::string> streamedPaths;
+  files.reserve(paths.size());
+  for (const auto &path : paths) {
+    if (StreamReader::isStreamPath(path)) {
+      throw std::runtime_error("A stream cannot be combined with other "
+                               "inputs: " + path);
+    }
+    if (isStreamed(path, context)) {
+      streamedPaths.push_back(path);
+      continue;
+    }
+    files.emplace_back(path, mapOptions(context));
+    if (!files.back().isOpen()) {
+      throw std::runtime_error("Cannot open file: " + path);
+    }
+    mappedPaths.push_back(path);
+  }
+  if (streamedPaths.empty()) {
+    return analyzeFiles(paths, files, context, progressCallback,
+                        wasCancelled);
+  }
+
+  // Compressed files (and every file with the pread backend) are streamed
+  // one run each after the mapped ones share a run; the results are
+  // merged. Progress is split evenly between runs.
+  const size_t parts = streamedPaths.size() + !mappedPaths.empty();
+  size_t part = 0;
+  auto partProgress = [&]() -> ProgressCallback {
+    if (!progressCallback)
+      return nullptr;
+    const float first = static_cast<float>(part) / parts;
+    return [&progressCallback, first, parts](float p) {
+      return progressCallback(first + p / static_cast<float>(parts));
+    };
+  };
+
+  AnalysisResult result;
+  bool cancelled = false;
+  if (!mappedPaths.empty()) {
+    result = analyzeFiles(mappedPaths, files, context, partProgress(),
+                          &cancelled);
+    ++part;
+  }
+  for (const auto &path : streamedPaths) {
+    if (cancelled)
+      break;
+    result.merge(run(path, context, partProgress(), &cancelled));
+    ++part;
+  }
+  result.coalesceTimeline();
+  result.selectTopErrors();
+  if (wasCancelled) {
+    *wasCancelled = cancelled;
+  }
+
+  // Back to input order. Files skipped by a cancel have no summary.
+  std::unordered_map<std::string_view, uint32_t> position;
+  for (size_t i = 0; i < paths.size(); ++i)
+    position.emplace(paths[i], static_cast<uint32_t>(i));
+  std::vector<uint32_t> order(result.files.size());
+  for (uint32_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return position.at(result.files[a].path) <
+           position.at(result.files[b].path);
+  });
+  std::vector<AnalysisResult::FileSummary> ordered;
+  std::vector<uint32_t> newIndex(result.files.size());
+  for (uint32_t i : order) {
+    newIndex[i] = static_cast<uint32_t>(ordered.size());
+    ordered.push_back(std::move(result.files[i]));
+  }
+  result.files = std::move(ordered);
+  for (auto &[code, samples] : result.errorSamples) {
+    for (auto &sample : samples)
+      sample.file = newIndex[sample.file];
+  }
+  return result;
+}
+
+AnalysisResult Pipeline::runBuffer(std::string_view data, uint64_t baseOffset,
+                                   const AnalysisContext &context,
+                                   ProgressCallback progressCallback,
+                                   bool *wasCancelled) {
+  if (wasCancelled) {
+    *wasCancelled = false;
+  }
+
+  // No file breakdown: samples keep their offsets from baseOffset
+  std::vector<MappedInput> inputs{{data, baseOffset, 0}};
+  return analyze(context, progressCallback, wasCancelled, RunLayout{},
+                 [&](PipelineRun &run, RunLayout &layout) {
+                   return runMapped(run, inputs, kMorselSize,
+                                    progressCallback, layout.chunks);
+                 });
+}
+
 } // namespace loganalyzer
@@ -2,8 +2,11 @@
 
 #include "AnalysisContext.h"
 #include "AnalysisResult.h"
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace loganalyzer {
 
@@ -12,13 +15,35 @@ using ProgressCallback = std::function<bool(float progress)>;
 
 class Pipeline {
 public:
-  // Run analysis pipeline on input file with given context
+  // Run analysis pipeline on input file with given context.
+  // "-", FIFOs and other non-regular files are streamed instead of mapped,
+  // as are gzip and zstd files (decompressed on the fly; see Decompressor).
   // Optional progress callback for cancellation and progress reporting
-  // wasCancelled is set to true if cancelled via callback
+  // wasCancelled is set to true if cancelled via callback or
+  // context.stopToken; it is only written by the calling thread
   static AnalysisResult run(const std::string &inputPath,
                             const AnalysisContext &context,
                             ProgressCallback progressCallback = nullptr,
                             bool *wasCancelled = nullptr);
+
+  // Several files analyzed as one run: morsels of all files share the
+  // pool, totals cover every file and AnalysisResult::files holds the
+  // per-file counts. Throws std::runtime_error if inputPaths is empty or a
+  // file cannot be opened or is a stream (streams can only be analyzed on
+  // their own). A path given twice is analyzed once. Compressed files are
+  // streamed in runs of their own and merged in.
+  static AnalysisResult run(const std::vector<std::string> &inputPaths,
+                            const AnalysisContext &context,
+                            ProgressCallback progressCallback = nullptr,
+                            bool *wasCancelled = nullptr);
+
+  // Same analysis on lines already in memory, e.g. the new tail of a
+  // mapped file starting at input offset baseOffset. Sample offsets are
+  // input offsets; line numbers count from the start of data.
+  static AnalysisResult runBuffer(std::string_view data, uint64_t baseOffset,
+                                  const AnalysisContext &context,
+                                  ProgressCallback progressCallback = nullptr,
+                                  bool *wasCancelled = nullptr);
 };
 
 } // namespace loganalyzer
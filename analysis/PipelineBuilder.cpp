@@ -0,0 +1,36 @@
+#include "PipelineBuilder.h"
+#include <utility>
+
+namespace loganalyzer {
+
+PipelineBuilder::PipelineBuilder(AnalysisContext context)
+    : context_(std::move(context)) {}
+
+PipelineBuilder &PipelineBuilder::addAnalyzer(AnalyzerFactory factory) {
+  context_.extraAnalyzers.push_back(std::move(factory));
+  return *this;
+}
+
+PipelineBuilder &PipelineBuilder::onProgress(ProgressCallback callback) {
+  progressCallback_ = std::move(callback);
+  return *this;
+}
+
+AnalysisResult PipelineBuilder::run(const std::string &inputPath,
+                                    bool *wasCancelled) const {
+  return Pipeline::run(inputPath, context_, progressCallback_, wasCancelled);
+}
+
+AnalysisResult PipelineBuilder::run(const std::vector<std::string> &inputPaths,
+                                    bool *wasCancelled) const {
+  return Pipeline::run(inputPaths, context_, progressCallback_, wasCancelled);
+}
+
+AnalysisResult PipelineBuilder::runBuffer(std::string_view data,
+                                          uint64_t baseOffset,
+                                          bool *wasCancelled) const {
+  return Pipeline::runBuffer(data, baseOffset, context_, progressCallback_,
+                             wasCancelled);
+}
+
+} // namespace loganalyzer
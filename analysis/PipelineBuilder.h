@@ -0,0 +1,65 @@
+#pragma once
+
+#include "AnalysisContext.h"
+#include "IAnalyzer.h"
+#include "Pipeline.h"
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Sets up and runs a Pipeline, including analyzers of your own.
+ *
+ * Every registered factory is called once per worker thread. An instance
+ * sees only the lines of its own thread and stores its result under its
+ * own name in AnalysisResult::custom in finalize(). The pipeline merges
+ * these per-thread (and per-file) slots with the result type's merge(), so
+ * the scan stays single-pass and parallel:
+ *
+ *   AnalysisResult result = PipelineBuilder(context)
+ *                               .addAnalyzer<TenantCountAnalyzer>()
+ *                               .run("app.log");
+ *   const TenantCounts *tenants =
+ *       result.custom.find<TenantCounts>("tenants");
+ */
+class PipelineBuilder {
+public:
+  PipelineBuilder() = default;
+  explicit PipelineBuilder(AnalysisContext context);
+
+  // Built-in analyzers, filters and tuning; extra analyzers are added on
+  // top of whatever the context already holds
+  AnalysisContext &context() { return context_; }
+  const AnalysisContext &context() const { return context_; }
+
+  PipelineBuilder &addAnalyzer(AnalyzerFactory factory);
+
+  // Analyzer constructed from copies of args in every worker
+  template <std::derived_from<IAnalyzer> A, typename... Args>
+  PipelineBuilder &addAnalyzer(Args... args) {
+    return addAnalyzer([args...]() -> std::unique_ptr<IAnalyzer> {
+      return std::make_unique<A>(args...);
+    });
+  }
+
+  PipelineBuilder &onProgress(ProgressCallback callback);
+
+  // Same inputs and errors as the Pipeline::run and runBuffer overloads
+  AnalysisResult run(const std::string &inputPath,
+                     bool *wasCancelled = nullptr) const;
+  AnalysisResult run(const std::vector<std::string> &inputPaths,
+                     bool *wasCancelled = nullptr) const;
+  AnalysisResult runBuffer(std::string_view data, uint64_t baseOffset = 0,
+                           bool *wasCancelled = nullptr) const;
+
+private:
+  AnalysisContext context_;
+  ProgressCallback progressCallback_;
+};
+
+} // namespace loganalyzer
@@ -0,0 +1,75 @@
+#include "QueryPlan.h"
+#include "BoundedTopErrorAnalyzer.h"
+#include "TimeRangeFilter.h"
+
+namespace loganalyzer {
+
+QueryPlan QueryPlan::build(const AnalysisContext &context) {
+  QueryPlan plan;
+  plan.timeline = context.timeline;
+
+  for (const auto &analyzer : makeAnalyzers(context)) {
+    plan.fields |= analyzer->requiredFields();
+  }
+  plan.fields |= TimeRangeFilter(context.fromTs, context.toTs).requiredFields();
+
+  // Buckets by minute/hour/weekday, counts errors and warnings
+  if (plan.timeline) {
+    plan.fields |= ParseFields{true, true, false};
+  }
+
+  return plan;
+}
+
+std::vector<std::unique_ptr<IAnalyzer>>
+QueryPlan::makeAnalyzers(const AnalysisContext &context) {
+  std::vector<std::unique_ptr<IAnalyzer>> analyzers;
+  if (context.countLevels) {
+    analyzers.push_back(std::make_unique<LevelCountAnalyzer>());
+  }
+  if (context.topErrors && context.topErrorCapacity > 0) {
+    // Fixed-size summary per thread, merged into one of the same size
+    analyzers.push_back(std::make_unique<BoundedTopErrorAnalyzer>(
+        context.topErrorCapacity, context.topErrorCount));
+  } else if (context.topErrors) {
+    // Each thread counts its share; the counts are merged in full
+    analyzers.push_back(
+        std::make_unique<TopErrorAnalyzer>(context.topErrorCount));
+  }
+  if (context.keyword.has_value()) {
+    analyzers.push_back(
+        std::make_unique<KeywordHitAnalyzer>(context.keyword.value()));
+  }
+  for (const auto &factory : context.extraAnalyzers) {
+    analyzers.push_back(factory());
+  }
+  return analyzers;
+}
+
+QueryPlan::AnalyzerSets
+QueryPlan::makeAnalyzerSet(const AnalysisContext &context) {
+  const bool keyword = context.keyword.has_value();
+  if (!context.extraAnalyzers.empty() ||
+      (context.topErrors && context.topErrorCapacity > 0)) {
+    return DynamicAnalyzerSet(makeAnalyzers(context));
+  }
+  if (!context.countLevels && !context.topErrors && !keyword) {
+    return AnalyzerSet<>();
+  }
+  if (context.countLevels && !context.topErrors && !keyword) {
+    return AnalyzerSet<LevelCountAnalyzer>(LevelCountAnalyzer());
+  }
+  if (context.countLevels && context.topErrors && !keyword) {
+    return AnalyzerSet<LevelCountAnalyzer, TopErrorAnalyzer>(
+        LevelCountAnalyzer(), TopErrorAnalyzer(context.topErrorCount));
+  }
+  if (context.countLevels && context.topErrors && keyword) {
+    return AnalyzerSet<LevelCountAnalyzer, TopErrorAnalyzer,
+                       KeywordHitAnalyzer>(
+        LevelCountAnalyzer(), TopErrorAnalyzer(context.topErrorCount),
+        KeywordHitAnalyzer(context.keyword.value()));
+  }
+  return DynamicAnalyzerSet(makeAnalyzers(context));
+}
+
+} // namespace loganalyzer
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../core/ParseFields.h"
+#include "AnalysisContext.h"
+#include "AnalyzerSet.h"
+#include "IAnalyzer.h"
+#include "KeywordHitAnalyzer.h"
+#include "LevelCountAnalyzer.h"
+#include "TopErrorAnalyzer.h"
+#include <memory>
+#include <variant>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief What a Pipeline run has to compute, derived from the context.
+ *
+ * Collects the fields required by the active analyzers, the time range
+ * filter and the timeline/heatmap, so the parser can skip extracting and
+ * validating everything else.
+ */
+struct QueryPlan {
+  // Analyzer combinations compiled into the pipeline's line loop; any
+  // other combination, or any extra analyzer, runs through the virtual
+  // DynamicAnalyzerSet
+  using AnalyzerSets =
+      std::variant<AnalyzerSet<>, AnalyzerSet<LevelCountAnalyzer>,
+                   AnalyzerSet<LevelCountAnalyzer, TopErrorAnalyzer>,
+                   AnalyzerSet<LevelCountAnalyzer, TopErrorAnalyzer,
+                               KeywordHitAnalyzer>,
+                   DynamicAnalyzerSet>;
+
+  ParseFields fields;
+  bool timeline = false;
+
+  static QueryPlan build(const AnalysisContext &context);
+
+  // Fresh analyzer instances for one worker
+  static std::vector<std::unique_ptr<IAnalyzer>>
+  makeAnalyzers(const AnalysisContext &context);
+  // The same analyzers, statically composed when the combination allows
+  static AnalyzerSets makeAnalyzerSet(const AnalysisContext &context);
+};
+
+} // namespace loganalyzer
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <concepts>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace loganalyzer {
+
+// A result a plugin analyzer can store in AnalysisResult: copyable, and
+// merge() folds in the result of another thread or file
+template <typename T>
+concept MergeableResult = std::copyable<T> && requires(T a, const T &b) {
+  { a.merge(b) } -> std::same_as<void>;
+};
+
+/**
+ * @brief Named, typed results of analyzers added through PipelineBuilder.
+ *
+ * Every worker's analyzer writes its own slot in finalize(); merging two
+ * AnalysisResults merges slots of the same name with T::merge, so the
+ * pipeline combines per-thread results without knowing their types.
+ */
+class ResultSlots {
+public:
+  ResultSlots() = default;
+  ResultSlots(const ResultSlots &other) { *this = other; }
+  ResultSlots &operator=(const ResultSlots &other) {
+    if (this != &other) {
+      slots_.clear();
+      for (const auto &[name, slot] : other.slots_)
+        slots_.emplace(name, slot->clone());
+    }
+    return *this;
+  }
+  ResultSlots(ResultSlots &&) noexcept = default;
+  ResultSlots &operator=(ResultSlots &&) noexcept = default;
+
+  // The slot called name, default-constructed on first use. Throws
+  // std::bad_cast if the slot exists with another type.
+  template <MergeableResult T> T &get(const std::string &name) {
+    auto &slot = slots_[name];
+    if (!slot)
+      slot = std::make_unique<Slot<T>>();
+    return dynamic_cast<Slot<T> &>(*slot).value;
+  }
+
+  // nullptr if there is no slot called name of type T
+  template <MergeableResult T> const T *find(const std::string &name) const {
+    auto it = slots_.find(name);
+    if (it == slots_.end())
+      return nullptr;
+    auto *slot = dynamic_cast<const Slot<T> *>(it->second.get());
+    return slot ? &slot->value : nullptr;
+  }
+
+  bool empty() const { return slots_.empty(); }
+  size_t size() const { return slots_.size(); }
+
+  // Slots missing here are copied; others are merged, if of the same type
+  void merge(const ResultSlots &other) {
+    for (const auto &[name, slot] : other.slots_) {
+      auto &mine = slots_[name];
+      if (mine) {
+        mine->merge(*slot);
+      } else {
+        mine = slot->clone();
+      }
+    }
+  }
+
+private:
+  struct SlotBase {
+    virtual ~SlotBase() = default;
+    virtual std::unique_ptr<SlotBase> clone() const = 0;
+    virtual void merge(const SlotBase &other) = 0;
+  };
+
+  template <MergeableResult T> struct Slot final : SlotBase {
+    T value;
+
+    std::unique_ptr<SlotBase> clone() const override {
+      return std::make_unique<Slot>(*this);
+    }
+    void merge(const SlotBase &other) override {
+      if (auto *same = dynamic_cast<const Slot *>(&other))
+        value.merge(same->value);
+    }
+  };
+
+  std::map<std::string, std::unique_ptr<SlotBase>> slots_;
+};
+
+} // namespace loganalyzer
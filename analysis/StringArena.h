@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Bump allocator for strings that live as long as the arena.
+ *
+ * Copies go into large blocks, so storing a string costs a memcpy instead
+ * of a heap allocation, and all of them are freed at once. Views returned
+ * by store() stay valid when the arena is moved.
+ */
+class StringArena {
+public:
+  explicit StringArena(size_t blockSize = 64 * 1024)
+      : blockSize_(blockSize) {}
+
+  std::string_view store(std::string_view text) {
+    if (text.empty())
+      return {};
+    if (text.size() > left_) {
+      // Oversized strings get a block of their own
+      const size_t size = std::max(blockSize_, text.size());
+      blocks_.push_back(std::make_unique<char[]>(size));
+      next_ = blocks_.back().get();
+      left_ = size;
+      reserved_ += size;
+    }
+    char *copy = next_;
+    std::memcpy(copy, text.data(), text.size());
+    next_ += text.size();
+    left_ -= text.size();
+    return {copy, text.size()};
+  }
+
+  // Bytes held in blocks, used or not
+  size_t bytesReserved() const { return reserved_; }
+
+private:
+  size_t blockSize_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char *next_ = nullptr;
+  size_t left_ = 0;
+  size_t reserved_ = 0;
+};
+
+} // namespace loganalyzer
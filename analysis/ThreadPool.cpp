@@ -0,0 +1,102 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace loganalyzer {
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+  threadCount = std::max(threadCount, 1u);
+  for (unsigned i = 0; i < threadCount; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (unsigned i = 0; i < threadCount; ++i) {
+    threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+ThreadPool &ThreadPool::instance() {
+  static ThreadPool pool(std::thread::hardware_concurrency());
+  return pool;
+}
+
+void ThreadPool::submit(std::vector<Task> tasks) {
+  if (tasks.empty())
+    return;
+
+  // Counted before they become visible, so pending_ never underflows
+  const size_t count = tasks.size();
+  pending_.fetch_add(count, std::memory_order_release);
+
+  // Contiguous runs per worker: task i goes to queue i * n / count
+  const size_t n = queues_.size();
+  size_t next = 0;
+  for (size_t q = 0; q < n && next < count; ++q) {
+    size_t end = (q + 1) * count / n;
+    if (end == next)
+      continue;
+    std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+    for (; next < end; ++next) {
+      queues_[q]->tasks.push_back(std::move(tasks[next]));
+    }
+  }
+
+  {
+    // Pairs with the predicate check in workerLoop: no lost wake-ups
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+  }
+  wake_.notify_all();
+}
+
+bool ThreadPool::popLocal(unsigned index, Task &task) {
+  Queue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty())
+    return false;
+  task = std::move(queue.tasks.front());
+  queue.tasks.pop_front();
+  return true;
+}
+
+bool ThreadPool::steal(unsigned index, Task &task) {
+  const size_t n = queues_.size();
+  for (size_t i = 1; i < n; ++i) {
+    Queue &victim = *queues_[(index + i) % n];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+  for (;;) {
+    Task task;
+    if (popLocal(index, task) || steal(index, task)) {
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      task(index);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    wake_.wait(lock, [this] {
+      return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_ && pending_.load(std::memory_order_acquire) == 0)
+      return;
+  }
+}
+
+} // namespace loganalyzer
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a task deque. submit() spreads a group of tasks over
+ * the deques in contiguous runs (neighbouring morsels stay on one worker);
+ * a worker pops from the front of its own deque and, once that is empty,
+ * steals from the back of the others.
+ *
+ * instance() is the process-wide pool shared by the CLI and GUI runs, so
+ * threads are started once rather than per analysis.
+ */
+class ThreadPool {
+public:
+  // Tasks receive the index of the worker running them, [0, size()).
+  // They must not throw.
+  using Task = std::function<void(unsigned worker)>;
+
+  explicit ThreadPool(unsigned threadCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // One worker per hardware thread, started on first use
+  static ThreadPool &instance();
+
+  unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+  // Queue tasks; they may start running before submit() returns.
+  // Must not be called from inside a task that then waits for them.
+  void submit(std::vector<Task> tasks);
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void workerLoop(unsigned index);
+  bool popLocal(unsigned index, Task &task);
+  bool steal(unsigned index, Task &task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::atomic<size_t> pending_{0}; // Queued, not yet taken
+  std::mutex sleepMutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+} // namespace loganalyzer
@@ -4,20 +4,13 @@ namespace loganalyzer {
 
 TimeRangeFilter::TimeRangeFilter(std::optional<Timestamp> from,
                                  std::optional<Timestamp> to)
-    : from_(from), to_(to) {}
-
-bool TimeRangeFilter::accept(const Timestamp &ts) const {
-  if (from_.has_value() && ts < from_.value()) {
-    return false;
-  }
-  if (to_.has_value() && ts > to_.value()) {
-    return false;
-  }
-  return true;
+    : active_(from.has_value() || to.has_value()) {
+  if (from.has_value())
+    from_ = from.value();
+  if (to.has_value())
+    to_ = to.value();
 }
 
-bool TimeRangeFilter::isActive() const {
-  return from_.has_value() || to_.has_value();
-}
+bool TimeRangeFilter::isActive() const { return active_; }
 
 } // namespace loganalyzer
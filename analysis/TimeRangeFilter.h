@@ -1,6 +1,8 @@
 #pragma once
 
+#include "../core/ParseFields.h"
 #include "../core/Timestamp.h"
+#include <cstdint>
 #include <optional>
 
 namespace loganalyzer {
@@ -10,13 +12,23 @@ public:
   TimeRangeFilter(std::optional<Timestamp> from, std::optional<Timestamp> to);
 
   // Returns true if entry timestamp is within range (inclusive)
-  bool accept(const Timestamp &ts) const;
+  // Called per line: two integer compares on the packed representation
+  bool accept(const Timestamp &ts) const {
+    return ts >= from_ && ts <= to_;
+  }
 
   bool isActive() const;
 
+  // The timestamp is only needed when a bound is set
+  ParseFields requiredFields() const { return {active_, false, false}; }
+
 private:
-  std::optional<Timestamp> from_;
-  std::optional<Timestamp> to_;
+  // Open ends default to the widest possible range. An invalid timestamp
+  // orders before everything, so it only passes when there is no lower
+  // bound.
+  Timestamp from_;
+  Timestamp to_ = Timestamp::fromEpochSeconds(INT64_MAX);
+  bool active_;
 };
 
 } // namespace loganalyzer
@@ -1,31 +1,75 @@
 #include "TopErrorAnalyzer.h"
 #include <algorithm>
+#include <functional>
+#include <string>
 
 namespace loganalyzer {
 
+namespace {
+
+constexpr size_t kInitialSlots = 256;
+
+} // namespace
+
 void TopErrorAnalyzer::process(const LogEntry &entry) {
   // Only track ERROR level messages
-  if (entry.level == LogLevel::ERROR) {
-    errorCounts_[std::string(entry.message)]++;
+  if (entry.level != LogLevel::ERROR)
+    return;
+
+  if ((size_ + 1) * 4 > slots_.size() * 3)
+    grow();
+
+  const std::string_view message = entry.message;
+  const uint64_t hash = std::hash<std::string_view>{}(message);
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    Slot &slot = slots_[i];
+    if (slot.count == 0) {
+      slot = {hash, arena_.store(message), 1};
+      ++size_;
+      return;
+    }
+    if (slot.hash == hash && slot.message == message) {
+      ++slot.count;
+      return;
+    }
+  }
+}
+
+void TopErrorAnalyzer::grow() {
+  std::vector<Slot> old = std::move(slots_);
+  slots_.assign(std::max(kInitialSlots, old.size() * 2), Slot{});
+  const size_t mask = slots_.size() - 1;
+  for (const Slot &slot : old) {
+    if (slot.count == 0)
+      continue;
+    size_t i = slot.hash & mask;
+    while (slots_[i].count != 0)
+      i = (i + 1) & mask;
+    slots_[i] = slot;
   }
 }
 
 void TopErrorAnalyzer::finalize(AnalysisResult &result) {
-  // Convert map to vector
-  std::vector<std::pair<std::string, uint64_t>> vec(errorCounts_.begin(),
-                                                    errorCounts_.end());
-
-  // Sort: descending by count, then alphabetically by message (deterministic)
-  std::sort(vec.begin(), vec.end(), [](const auto &a, const auto &b) {
-    if (a.second != b.second) {
-      return a.second > b.second; // Higher count first
-    }
-    return a.first < b.first; // Alphabetical tie-break
+  // Ordered as AnalysisResult::ErrorCount, mostly by the stored hash;
+  // sorted as slots and copied out once
+  std::vector<const Slot *> sorted;
+  sorted.reserve(size_);
+  for (const Slot &slot : slots_) {
+    if (slot.count != 0)
+      sorted.push_back(&slot);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const Slot *a, const Slot *b) {
+    return a->hash != b->hash ? a->hash < b->hash : a->message < b->message;
   });
 
-  // Take top 10
-  size_t limit = std::min(vec.size(), size_t(10));
-  result.topErrors.assign(vec.begin(), vec.begin() + limit);
+  std::vector<AnalysisResult::ErrorCount> counts;
+  counts.reserve(sorted.size());
+  for (const Slot *slot : sorted)
+    counts.push_back({slot->hash, std::string(slot->message), slot->count});
+
+  result.errorCounts = std::move(counts);
+  result.topErrorLimit = topN_;
 }
 
 } // namespace loganalyzer
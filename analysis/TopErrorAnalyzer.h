@@ -1,18 +1,51 @@
 #pragma once
 
 #include "IAnalyzer.h"
-#include <map>
-#include <string>
+#include "StringArena.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
 
 namespace loganalyzer {
 
-class TopErrorAnalyzer : public IAnalyzer {
+/**
+ * @brief Counts ERROR messages and reports the most frequent ones.
+ *
+ * Messages are counted in a flat open-addressing table keyed by their hash.
+ * A repeated message costs one hash and a compare against the stored copy,
+ * with no allocation. Each distinct message is copied once into the
+ * analyzer's arena, because the input it points into (a morsel window, a
+ * stream block) is released after its chunk.
+ *
+ * finalize() hands the whole table to AnalysisResult::errorCounts; the top
+ * N are selected from the exact totals once all workers are merged
+ * (AnalysisResult::selectTopErrors()).
+ */
+class TopErrorAnalyzer final : public IAnalyzer {
 public:
+  static constexpr size_t kDefaultTopN = 10;
+
+  explicit TopErrorAnalyzer(size_t topN = kDefaultTopN) : topN_(topN) {}
+
   void process(const LogEntry &entry) override;
   void finalize(AnalysisResult &result) override;
+  ParseFields requiredFields() const override { return {false, true, true}; }
+
+  size_t distinctMessages() const { return size_; }
 
 private:
-  std::map<std::string, uint64_t> errorCounts_;
+  struct Slot {
+    uint64_t hash = 0;
+    std::string_view message; // In arena_
+    uint64_t count = 0;       // 0 for a free slot
+  };
+
+  void grow();
+
+  size_t topN_;
+  std::vector<Slot> slots_; // Power-of-two size, at most 3/4 full
+  size_t size_ = 0;
+  StringArena arena_;
 };
 
 } // namespace loganalyzer
@@ -1,17 +1,42 @@
 #pragma once
 
+#include "../analysis/AnalysisContext.h"
 #include "../core/Timestamp.h"
+#include <atomic>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace loganalyzer {
 
 struct AppRequest {
   std::string inputPath;
+  // Files, directories or glob patterns analyzed together into one result;
+  // used instead of inputPath when non-empty (see InputPaths)
+  std::vector<std::string> inputPaths;
   std::optional<Timestamp> fromTimestamp;
   std::optional<Timestamp> toTimestamp;
   std::optional<std::string> keyword;
   std::string customPattern;
+
+  // Optional outputs (see AnalysisContext)
+  bool countLevels = true;
+  bool topErrors = true;
+  size_t topErrorCount = 10;
+  size_t topErrorCapacity = 0; // Above 0: bounded, approximate top errors
+  bool timeline = true;
+
+  // Input backend and memory-mapped input tuning (see AnalysisContext)
+  IoBackend io = IoBackend::Mmap;
+  bool mapPopulate = false;
+  bool mapHugePages = false;
+  uint64_t mapBudget = 0; // Bytes; 0 maps files whole
+
+  // Optional cancel flag (see AnalysisContext::stopToken)
+  const std::atomic<bool> *stopToken = nullptr;
+
+  bool operator==(const AppRequest &) const = default;
 };
 
 } // namespace loganalyzer
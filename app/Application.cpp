@@ -1,10 +1,53 @@
 #include "Application.h"
 #include "../analysis/AnalysisContext.h"
 #include "../analysis/Pipeline.h"
+#include "../io/InputPaths.h"
 #include "../io/MemoryMappedFile.h"
+#include "../io/StreamReader.h"
 
 namespace loganalyzer {
 
+namespace {
+
+AnalysisContext makeContext(const AppRequest &request) {
+  AnalysisContext context;
+  context.fromTs = request.fromTimestamp;
+  context.toTs = request.toTimestamp;
+  context.keyword = request.keyword;
+  context.customPattern = request.customPattern;
+  context.countLevels = request.countLevels;
+  context.topErrors = request.topErrors;
+  context.topErrorCount = request.topErrorCount;
+  context.topErrorCapacity = request.topErrorCapacity;
+  context.timeline = request.timeline;
+  context.io = request.io;
+  context.mapPopulate = request.mapPopulate;
+  context.mapHugePages = request.mapHugePages;
+  context.mapBudget = request.mapBudget;
+  context.stopToken = request.stopToken;
+  return context;
+}
+
+// Maps an exception from the pipeline to a status and message
+void setError(AppResult &result) {
+  try {
+    throw;
+  } catch (const std::runtime_error &e) {
+    // Pipeline-specific errors
+    result.status = AppStatus::PIPELINE_ERROR;
+    result.message = std::string("Pipeline error: ") + e.what();
+  } catch (const std::exception &e) {
+    // Generic errors
+    result.status = AppStatus::IO_ERROR;
+    result.message = std::string("I/O error: ") + e.what();
+  } catch (...) {
+    result.status = AppStatus::IO_ERROR;
+    result.message = "Unknown error during analysis";
+  }
+}
+
+} // namespace
+
 AppResult Application::run(const AppRequest &request,
                            ProgressCallback progressCallback) {
   AppResult result;
@@ -19,51 +62,91 @@ void Application::runHeadless(const AppRequest &request, AppResult &result,
   result.wasCancelled = false;
 
   // Validate input
-  if (request.inputPath.empty()) {
+  std::vector<std::string> inputs = request.inputPaths;
+  if (inputs.empty() && !request.inputPath.empty())
+    inputs.push_back(request.inputPath);
+  if (inputs.empty()) {
     result.status = AppStatus::INVALID_ARGS;
     result.message = "Input path cannot be empty";
     return;
   }
 
-  // Check if file exists and is readable
-  MemoryMappedFile testReader(request.inputPath);
-  if (!testReader.isOpen()) {
+  std::vector<std::string> files;
+  std::string error;
+  if (!InputPaths::expand(inputs, files, error)) {
     result.status = AppStatus::INPUT_IO_ERROR;
-    result.message = "Cannot open file (not found or permission denied)";
+    result.message = error;
     return;
   }
 
-  // Build analysis context
-  AnalysisContext context;
-  context.fromTs = request.fromTimestamp;
-  context.toTs = request.toTimestamp;
-  context.keyword = request.keyword;
-  context.customPattern = request.customPattern;
+  // Check if each file exists and is readable. Streams (stdin, pipes) are
+  // not probed: opening a FIFO would consume its writer.
+  for (const auto &file : files) {
+    if (files.size() > 1 && StreamReader::isStreamPath(file)) {
+      result.status = AppStatus::INVALID_ARGS;
+      result.message = "A stream cannot be combined with other inputs: " + file;
+      return;
+    }
+    if (!StreamReader::isStreamPath(file) &&
+        !MemoryMappedFile(file).isOpen()) {
+      result.status = AppStatus::INPUT_IO_ERROR;
+      result.message =
+          "Cannot open file (not found or permission denied): " + file;
+      return;
+    }
+  }
 
   // Run pipeline with progress callback
   try {
     result.analysisResult = Pipeline::run(
-        request.inputPath, context, progressCallback, &result.wasCancelled);
+        files, makeContext(request), progressCallback, &result.wasCancelled);
 
     if (result.wasCancelled) {
       result.status = AppStatus::OK; // Cancellation is not an error
       result.message = "Analysis cancelled by user";
     }
-  } catch (const std::runtime_error &e) {
-    // Pipeline-specific errors
-    result.status = AppStatus::PIPELINE_ERROR;
-    result.message = std::string("Pipeline error: ") + e.what();
-    return;
-  } catch (const std::exception &e) {
-    // Generic errors
-    result.status = AppStatus::IO_ERROR;
-    result.message = std::string("I/O error: ") + e.what();
-    return;
   } catch (...) {
-    result.status = AppStatus::IO_ERROR;
-    result.message = "Unknown error during analysis";
-    return;
+    setError(result);
+  }
+}
+
+AppResult Application::follow(const AppRequest &request,
+                              ProgressCallback progressCallback) {
+  // Only a single uncompressed regular file can be followed
+  if (request.inputPath.empty() || !request.inputPaths.empty() ||
+      StreamReader::needsStreaming(request.inputPath)) {
+    followSession_.reset();
+    return run(request, progressCallback);
+  }
+
+  AppResult result;
+  result.status = AppStatus::OK;
+  result.message = "Analysis completed successfully";
+
+  if (!MemoryMappedFile(request.inputPath).isOpen()) {
+    followSession_.reset();
+    result.status = AppStatus::INPUT_IO_ERROR;
+    result.message = "Cannot open file (not found or permission denied)";
+    return result;
+  }
+
+  if (!followSession_ || !(request == followRequest_)) {
+    followSession_ = std::make_unique<FollowSession>(request.inputPath,
+                                                     makeContext(request));
+    followRequest_ = request;
   }
+
+  try {
+    followSession_->update(progressCallback, &result.wasCancelled);
+    if (result.wasCancelled) {
+      result.message = "Analysis cancelled by user";
+    }
+    result.analysisResult = followSession_->result();
+  } catch (...) {
+    followSession_.reset();
+    setError(result);
+  }
+  return result;
 }
 
 } // namespace loganalyzer
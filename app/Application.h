@@ -1,7 +1,9 @@
 #pragma once
 
+#include "../analysis/FollowSession.h"
 #include "AppRequest.h"
 #include "AppResult.h"
+#include <memory>
 
 namespace loganalyzer {
 
@@ -16,6 +18,17 @@ public:
   // Useful for HTTP/WASM/embedded frontends
   void runHeadless(const AppRequest &request, AppResult &result,
                    ProgressCallback progressCallback = nullptr);
+
+  // Follow mode: like run(), but repeated calls with the same request only
+  // analyze lines appended to the file since the previous call (see
+  // FollowSession). A different request starts a new session. Streams
+  // and compressed files cannot be followed and are analyzed in full.
+  AppResult follow(const AppRequest &request,
+                   ProgressCallback progressCallback = nullptr);
+
+private:
+  std::unique_ptr<FollowSession> followSession_;
+  AppRequest followRequest_;
 };
 
 } // namespace loganalyzer
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace loganalyzer::bench {
+
+// Synthetic log text in the standard format, roughly targetBytes long.
+// invalidEvery > 0 turns every N-th line into garbage.
+std::string makeSampleLog(size_t targetBytes, size_t invalidEvery = 0);
+
+// Best-of-N wall time of fn() in seconds
+template <typename Fn> double measureSeconds(Fn &&fn, int repetitions = 5) {
+  double best = 1e300;
+  for (int i = 0; i < repetitions; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() < best)
+      best = elapsed.count();
+  }
+  return best;
+}
+
+inline void reportThroughput(const char *name, size_t bytes, double seconds) {
+  std::printf("  %-36s %9.1f MB/s  (%.3f ms)\n", name,
+              static_cast<double>(bytes) / seconds / (1024.0 * 1024.0),
+              seconds * 1000.0);
+}
+
+// Keeps the optimizer from discarding benchmark results
+template <typename T> void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Benchmark suites
+void runLineScannerBench();
+void runParserBench();
+void runTimestampBench();
+void runIoBench();
+void runTopErrorsBench();
+
+} // namespace loganalyzer::bench
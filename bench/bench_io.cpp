@@ -0,0 +1,82 @@
+#include "../analysis/Pipeline.h"
+#include "Bench.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace loganalyzer::bench {
+
+namespace {
+
+// Evicts the file from the page cache, so the next run reads it from disk.
+// Works without privileges for clean pages, hence the sync.
+void dropFromPageCache(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return;
+  ::fdatasync(fd);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+struct Variant {
+  const char *name;
+  void (*configure)(AnalysisContext &context);
+};
+
+} // namespace
+
+void runIoBench() {
+  // Several times the morsel size per worker, written in pieces to keep
+  // the generator's memory down
+  const std::string path = (std::filesystem::temp_directory_path() /
+                            "loganalyzer_bench_io.log")
+                               .string();
+  {
+    const std::string piece = makeSampleLog(64 * 1024 * 1024, 50);
+    std::ofstream out(path, std::ios::binary);
+    for (int i = 0; i < 4; ++i)
+      out << piece;
+  }
+  const size_t bytes = std::filesystem::file_size(path);
+
+  const Variant variants[] = {
+      {"mmap, no hints", [](AnalysisContext &c) { c.mapReadahead = false; }},
+      {"mmap + readahead (default)", [](AnalysisContext &) {}},
+      {"mmap + MAP_POPULATE", [](AnalysisContext &c) { c.mapPopulate = true; }},
+      {"mmap + huge pages", [](AnalysisContext &c) { c.mapHugePages = true; }},
+      {"pread", [](AnalysisContext &c) { c.io = IoBackend::Pread; }},
+  };
+
+  for (const Variant &variant : variants) {
+    AnalysisContext context;
+    variant.configure(context);
+
+    // Cold: page cache dropped before every run (not timed)
+    double cold = 1e300;
+    for (int i = 0; i < 3; ++i) {
+      dropFromPageCache(path);
+      cold = std::min(cold, measureSeconds(
+                                [&] {
+                                  doNotOptimize(
+                                      Pipeline::run(path, context).totalLines);
+                                },
+                                1));
+    }
+    // Warm: the file is cached after the last cold run
+    double warm = measureSeconds(
+        [&] { doNotOptimize(Pipeline::run(path, context).totalLines); }, 3);
+
+    reportThroughput((std::string(variant.name) + ", cold").c_str(), bytes,
+                     cold);
+    reportThroughput((std::string(variant.name) + ", warm").c_str(), bytes,
+                     warm);
+  }
+
+  std::filesystem::remove(path);
+}
+
+} // namespace loganalyzer::bench
@@ -0,0 +1,45 @@
+#include "../io/LineScanner.h"
+#include "Bench.h"
+#include <string_view>
+
+namespace loganalyzer::bench {
+
+void runLineScannerBench() {
+  const std::string log = makeSampleLog(64 * 1024 * 1024);
+  const std::string_view data = log;
+
+  // Baseline: the find('\n') loop previously used by Pipeline and LogViewer
+  double seconds = measureSeconds([&] {
+    size_t lines = 0;
+    size_t pos = 0;
+    while (pos < data.size()) {
+      size_t nl = data.find('\n', pos);
+      if (nl == std::string_view::npos)
+        nl = data.size();
+      ++lines;
+      pos = nl + 1;
+    }
+    doNotOptimize(lines);
+  });
+  reportThroughput("string_view::find loop", data.size(), seconds);
+
+  for (ScanKernel kernel :
+       {ScanKernel::Scalar, ScanKernel::SSE2, ScanKernel::AVX2}) {
+    if (!LineScanner::isSupported(kernel))
+      continue;
+    seconds = measureSeconds([&] {
+      LineScanner scanner(data, kernel);
+      LineSpan spans[256];
+      size_t lines = 0;
+      size_t count;
+      while ((count = scanner.nextBatch(spans, 256)) > 0)
+        lines += count;
+      doNotOptimize(lines);
+    });
+    std::string name = std::string("LineScanner (") +
+                       LineScanner::kernelName(kernel) + ")";
+    reportThroughput(name.c_str(), data.size(), seconds);
+  }
+}
+
+} // namespace loganalyzer::bench
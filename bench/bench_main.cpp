@@ -0,0 +1,64 @@
+#include "Bench.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace loganalyzer::bench;
+
+namespace loganalyzer::bench {
+
+std::string makeSampleLog(size_t targetBytes, size_t invalidEvery) {
+  static const char *levels[] = {"INFO", "INFO", "INFO", "WARNING", "ERROR"};
+  static const char *messages[] = {
+      "User login successful for account 4711",
+      "Database connection pool exhausted, retrying",
+      "Request GET /api/v1/orders completed in 12ms",
+      "Cache miss for key session:8842",
+      "Disk space low on /var/log",
+  };
+
+  std::string out;
+  out.reserve(targetBytes + 128);
+  char line[160];
+  size_t n = 0;
+  while (out.size() < targetBytes) {
+    if (invalidEvery > 0 && n % invalidEvery == invalidEvery - 1) {
+      out += "    at com.example.Service.handle(Service.java:42)\n";
+    } else {
+      unsigned secs = static_cast<unsigned>(n / 16);
+      std::snprintf(line, sizeof(line),
+                    "[2026-01-05 %02u:%02u:%02u] [%s] %s\n",
+                    (secs / 3600) % 24, (secs / 60) % 60, secs % 60,
+                    levels[n % 5], messages[(n / 5) % 5]);
+      out += line;
+    }
+    ++n;
+  }
+  return out;
+}
+
+} // namespace loganalyzer::bench
+
+int main(int argc, char *argv[]) {
+  struct Suite {
+    const char *name;
+    void (*run)();
+  };
+  const Suite suites[] = {
+      {"line_scanner", runLineScannerBench},
+      {"parsers", runParserBench},
+      {"timestamp", runTimestampBench},
+      {"io", runIoBench},
+      {"top_errors", runTopErrorsBench},
+  };
+
+  // Optional argument: run only suites whose name contains it
+  const char *filter = argc > 1 ? argv[1] : "";
+  for (const auto &suite : suites) {
+    if (std::strstr(suite.name, filter) == nullptr)
+      continue;
+    std::printf("== %s ==\n", suite.name);
+    suite.run();
+    std::printf("\n");
+  }
+  return 0;
+}
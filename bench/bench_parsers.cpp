@@ -0,0 +1,70 @@
+#include "../core/FormatParser.h"
+#include "../core/PatternLogParser.h"
+#include "../core/StandardLogParser.h"
+#include "Bench.h"
+#include <algorithm>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loganalyzer::bench {
+
+namespace {
+
+void runParser(const char *name, const ILogParser &parser,
+               const std::vector<std::string_view> &lines, size_t bytes) {
+  double seconds = measureSeconds([&] {
+    size_t parsed = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+      parsed += std::holds_alternative<LogEntry>(parser.parse(lines[i], i));
+    }
+    doNotOptimize(parsed);
+  });
+  reportThroughput(name, bytes, seconds);
+
+  // Same lines through parseBatch, one virtual call per block
+  ParsedBatch batch;
+  seconds = measureSeconds([&] {
+    size_t parsed = 0;
+    for (size_t i = 0; i < lines.size(); i += ParsedBatch::kCapacity) {
+      size_t n = std::min(ParsedBatch::kCapacity, lines.size() - i);
+      parser.parseBatch(std::span(lines.data() + i, n), batch);
+      for (size_t j = 0; j < n; ++j)
+        parsed += batch.valid[j];
+    }
+    doNotOptimize(parsed);
+  });
+  std::string batchName = std::string(name) + " batch";
+  reportThroughput(batchName.c_str(), bytes, seconds);
+}
+
+} // namespace
+
+void runParserBench() {
+  const std::string log = makeSampleLog(32 * 1024 * 1024, 50);
+  std::vector<std::string_view> lines;
+  std::string_view data = log;
+  for (size_t pos = 0; pos < data.size();) {
+    size_t nl = data.find('\n', pos);
+    lines.push_back(data.substr(pos, nl - pos));
+    pos = nl + 1;
+  }
+
+  runParser("StandardLogParser", StandardLogParser(), lines, data.size());
+  runParser("FormatParser<[%D %T] [%L] %M>",
+            FormatParser<"[%D %T] [%L] %M">(), lines, data.size());
+  runParser("PatternLogParser (compiled)",
+            PatternLogParser("[%D %T] [%L] %M"), lines, data.size());
+
+  // Regex fallback on a smaller slice, it is orders of magnitude slower
+  std::vector<std::string_view> slice(
+      lines.begin(), lines.begin() + std::min<size_t>(lines.size(), 20000));
+  size_t sliceBytes = 0;
+  for (auto l : slice)
+    sliceBytes += l.size() + 1;
+  runParser("PatternLogParser (regex)", PatternLogParser("[%D %T] %M] %M"),
+            slice, sliceBytes);
+}
+
+} // namespace loganalyzer::bench
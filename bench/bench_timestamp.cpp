@@ -0,0 +1,36 @@
+#include "../core/Timestamp.h"
+#include "Bench.h"
+#include <string>
+#include <vector>
+
+namespace loganalyzer::bench {
+
+void runTimestampBench() {
+  // One timestamp per second over a few days, plus some 31 Februaries
+  std::vector<std::string> samples;
+  char buf[32];
+  for (unsigned i = 0; i < 400000; ++i) {
+    unsigned secs = i * 7;
+    unsigned day = i % 50 == 0 ? 31 : 1 + (secs / 86400) % 28;
+    std::snprintf(buf, sizeof(buf), "2024-02-%02u %02u:%02u:%02u", day,
+                  (secs / 3600) % 24, (secs / 60) % 60, secs % 60);
+    samples.emplace_back(buf);
+  }
+  const size_t bytes = samples.size() * 19;
+
+  auto run = [&](bool (*parse)(std::string_view, Timestamp &)) {
+    return measureSeconds([&] {
+      size_t valid = 0;
+      Timestamp ts;
+      for (const auto &s : samples)
+        valid += parse(s, ts);
+      doNotOptimize(valid);
+      doNotOptimize(ts);
+    });
+  };
+
+  reportThroughput("Timestamp::parseScalar", bytes, run(Timestamp::parseScalar));
+  reportThroughput("Timestamp::parse (SWAR)", bytes, run(Timestamp::parse));
+}
+
+} // namespace loganalyzer::bench
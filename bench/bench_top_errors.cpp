@@ -0,0 +1,156 @@
+#include "../analysis/BoundedTopErrorAnalyzer.h"
+#include "../analysis/TopErrorAnalyzer.h"
+#include "Bench.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace loganalyzer::bench {
+
+namespace {
+
+// The previous TopErrorAnalyzer: one std::string and an ordered map lookup
+// per ERROR line, then the whole map sorted
+void countWithMap(const std::vector<LogEntry> &entries) {
+  std::map<std::string, uint64_t> counts;
+  for (const LogEntry &entry : entries) {
+    if (entry.level == LogLevel::ERROR)
+      counts[std::string(entry.message)]++;
+  }
+  std::vector<std::pair<std::string, uint64_t>> vec(counts.begin(),
+                                                    counts.end());
+  std::sort(vec.begin(), vec.end(), [](const auto &a, const auto &b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  });
+  vec.resize(std::min<size_t>(vec.size(), TopErrorAnalyzer::kDefaultTopN));
+  doNotOptimize(vec.size());
+}
+
+void countWithAnalyzer(const std::vector<LogEntry> &entries) {
+  TopErrorAnalyzer analyzer;
+  for (const LogEntry &entry : entries)
+    analyzer.process(entry);
+  AnalysisResult result;
+  analyzer.finalize(result);
+  result.selectTopErrors();
+  doNotOptimize(result.topErrors.size());
+}
+
+// Space-Saving with the default number of counters: memory stays fixed
+// however many distinct messages there are
+void countBounded(const std::vector<LogEntry> &entries) {
+  BoundedTopErrorAnalyzer analyzer;
+  for (const LogEntry &entry : entries)
+    analyzer.process(entry);
+  AnalysisResult result;
+  analyzer.finalize(result);
+  result.selectTopErrors();
+  doNotOptimize(result.topErrors.size());
+}
+
+// Workers and morsel interleaving of the pipeline, in entries
+constexpr unsigned kWorkers = 4;
+constexpr size_t kMorselEntries = 4096;
+
+// Per-worker results combined as before (summing each worker's top-N list)
+// and now (merging the full count tables), with how far the old answer is
+// off
+void runMergeCase(const std::string &name,
+                  const std::vector<LogEntry> &entries) {
+  std::vector<TopErrorAnalyzer> analyzers(kWorkers);
+  for (size_t i = 0; i < entries.size(); ++i)
+    analyzers[i / kMorselEntries % kWorkers].process(entries[i]);
+
+  std::vector<AnalysisResult> partial(kWorkers);
+  const double finalizeSeconds = measureSeconds(
+      [&] {
+        for (unsigned w = 0; w < kWorkers; ++w)
+          analyzers[w].finalize(partial[w]);
+      },
+      3);
+  // The old scheme's per-worker top-N lists
+  for (AnalysisResult &result : partial)
+    result.selectTopErrors();
+
+  std::vector<std::pair<std::string, uint64_t>> approximate;
+  const double listSeconds = measureSeconds(
+      [&] {
+        std::map<std::string, uint64_t> sum;
+        for (const AnalysisResult &result : partial) {
+          for (const auto &[message, count] : result.topErrors)
+            sum[message] += count;
+        }
+        approximate.assign(sum.begin(), sum.end());
+        std::sort(approximate.begin(), approximate.end(),
+                  [](const auto &a, const auto &b) {
+                    return a.second != b.second ? a.second > b.second
+                                                : a.first < b.first;
+                  });
+        approximate.resize(std::min(approximate.size(),
+                                    TopErrorAnalyzer::kDefaultTopN));
+      },
+      3);
+
+  AnalysisResult exact;
+  const double tableSeconds = measureSeconds(
+      [&] {
+        AnalysisResult merged;
+        for (const AnalysisResult &result : partial)
+          merged.merge(result);
+        merged.selectTopErrors();
+        exact = std::move(merged);
+      },
+      3);
+
+  size_t wrong = 0;
+  for (size_t i = 0; i < exact.topErrors.size(); ++i) {
+    wrong += i >= approximate.size() || approximate[i] != exact.topErrors[i];
+  }
+  std::printf("  %-36s %9.3f ms  finalize, %zu workers\n",
+              (name + ", full tables").c_str(), finalizeSeconds * 1000.0,
+              static_cast<size_t>(kWorkers));
+  std::printf("  %-36s %9.3f ms  merge, %zu of %zu wrong\n",
+              (name + ", top-N lists").c_str(), listSeconds * 1000.0, wrong,
+              exact.topErrors.size());
+  std::printf("  %-36s %9.3f ms  merge, exact\n",
+              (name + ", full tables").c_str(), tableSeconds * 1000.0);
+}
+
+void runCase(const char *name, size_t distinct) {
+  // Messages live in one buffer, like lines of a mapped file
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < distinct; ++i) {
+    messages.push_back("Request failed for order " + std::to_string(i) +
+                       ": upstream timeout after 3000ms");
+  }
+  std::vector<LogEntry> entries;
+  size_t bytes = 0;
+  for (size_t i = 0; i < 2'000'000; ++i) {
+    // Skewed: low indices repeat more often
+    const size_t pick = (i * 2654435761u) % distinct % (1 + i % distinct);
+    entries.push_back({{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "",
+                       messages[pick]});
+    bytes += messages[pick].size();
+  }
+
+  std::string label = std::string(name) + ", std::map";
+  reportThroughput(label.c_str(), bytes,
+                   measureSeconds([&] { countWithMap(entries); }, 3));
+  label = std::string(name) + ", TopErrorAnalyzer";
+  reportThroughput(label.c_str(), bytes,
+                   measureSeconds([&] { countWithAnalyzer(entries); }, 3));
+  label = std::string(name) + ", bounded";
+  reportThroughput(label.c_str(), bytes,
+                   measureSeconds([&] { countBounded(entries); }, 3));
+  runMergeCase(name, entries);
+}
+
+} // namespace
+
+void runTopErrorsBench() {
+  runCase("50 messages", 50);
+  runCase("500k messages", 500'000);
+}
+
+} // namespace loganalyzer::bench
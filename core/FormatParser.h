@@ -0,0 +1,216 @@
+#pragma once
+
+#include "ILogParser.h"
+#include "PatternTokens.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace loganalyzer {
+
+// String literal usable as a template argument: FormatParser<"[%D %T] %M">
+template <size_t N> struct FixedString {
+  char value[N] = {};
+
+  constexpr FixedString(const char (&str)[N]) {
+    std::copy_n(str, N, value);
+  }
+
+  constexpr std::string_view view() const { return {value, N - 1}; }
+};
+
+/**
+ * @brief Log parser specialized at compile time for one fixed format.
+ *
+ * Takes the same %D/%T/%L/%M pattern syntax as PatternLogParser and accepts
+ * exactly the same lines, but the token list, literal text, field order and
+ * every offset that does not depend on a variable-width field are resolved
+ * by the compiler. The matching loop is fully unrolled.
+ *
+ * Formats that would need regex backtracking are rejected at compile time.
+ * Use FormatRegistry to pick an instantiation for a runtime pattern string.
+ */
+template <FixedString Format> class FormatParser final : public ILogParser {
+public:
+  ParseResult parse(std::string_view line, size_t lineNumber) const override {
+    LogEntry entry{};
+    if (!match(line, entry)) {
+      return ParseError{ParseErrorCode::BadFormat, line, lineNumber};
+    }
+    return entry;
+  }
+
+  void parseBatch(std::span<const std::string_view> lines,
+                  ParsedBatch &out) const override {
+    out.size = lines.size();
+    for (size_t i = 0; i < lines.size(); ++i) {
+      LogEntry entry{};
+      if (match(lines[i], entry)) {
+        out.setEntry(i, lines[i], entry);
+      } else {
+        out.setError(i, ParseErrorCode::BadFormat);
+      }
+    }
+  }
+
+  static constexpr std::string_view format() { return kFormat; }
+
+private:
+  static constexpr std::string_view kFormat = Format.view();
+
+  static constexpr size_t countTokens() {
+    size_t count = 0;
+    pattern::tokenize(kFormat, [&](const pattern::Token &) { ++count; });
+    return count;
+  }
+
+  static constexpr size_t kTokenCount = countTokens();
+
+  static constexpr std::array<pattern::Token, kTokenCount> makeTokens() {
+    std::array<pattern::Token, kTokenCount> tokens{};
+    size_t i = 0;
+    pattern::tokenize(kFormat,
+                      [&](const pattern::Token &t) { tokens[i++] = t; });
+    return tokens;
+  }
+
+  static constexpr std::array<pattern::Token, kTokenCount> kTokens =
+      makeTokens();
+
+  static_assert(pattern::isDeterministic(kTokens.data(), kTokenCount, kFormat),
+                "Format needs regex backtracking; use PatternLogParser");
+
+  // Shortest line the format can match
+  static constexpr size_t minWidth(const pattern::Token &t) {
+    switch (t.type) {
+    case pattern::TokenType::Literal:
+      return t.length;
+    case pattern::TokenType::Date:
+      return 10;
+    case pattern::TokenType::Time:
+      return 8;
+    case pattern::TokenType::Level:
+      return 1;
+    default:
+      return 0;
+    }
+  }
+
+  static constexpr size_t computeMinLength() {
+    size_t total = 0;
+    for (const auto &t : kTokens)
+      total += minWidth(t);
+    return total;
+  }
+
+  static constexpr size_t kMinLength = computeMinLength();
+
+  // Offset of each token when every field before it has a fixed width,
+  // npos once a variable-width field has been passed.
+  static constexpr std::array<size_t, kTokenCount + 1> computeOffsets() {
+    std::array<size_t, kTokenCount + 1> offsets{};
+    size_t pos = 0;
+    for (size_t i = 0; i < kTokenCount; ++i) {
+      offsets[i] = pos;
+      if (pos == pattern::npos)
+        continue;
+      auto type = kTokens[i].type;
+      if (type == pattern::TokenType::Literal ||
+          type == pattern::TokenType::Date) {
+        pos += minWidth(kTokens[i]);
+      } else {
+        pos = pattern::npos;
+      }
+    }
+    offsets[kTokenCount] = pos;
+    return offsets;
+  }
+
+  static constexpr std::array<size_t, kTokenCount + 1> kStaticOffsets =
+      computeOffsets();
+
+  bool match(std::string_view line, LogEntry &entry) const {
+    entry.rawLine = line;
+
+    Captures captures{entry, fields_, {}, {}};
+    if (line.size() < kMinLength || !matchFrom<0>(line, 0, captures))
+      return false;
+
+    if (fields_.timestamp && !captures.date.empty() &&
+        !captures.time.empty()) {
+      pattern::parseDateTime(captures.date, captures.time, entry.ts);
+    }
+    return true;
+  }
+
+  struct Captures {
+    LogEntry &entry;
+    const ParseFields &wanted;
+    std::string_view date;
+    std::string_view time;
+  };
+
+  template <size_t I>
+  static bool matchFrom(std::string_view line, size_t pos,
+                        Captures &captures) {
+    // Statically known offsets lie inside kMinLength, already checked
+    constexpr bool kStatic = kStaticOffsets[I] != pattern::npos;
+    if constexpr (kStatic)
+      pos = kStaticOffsets[I];
+
+    if constexpr (I == kTokenCount) {
+      return pos == line.size();
+    } else {
+      constexpr pattern::Token tok = kTokens[I];
+      size_t end;
+
+      if constexpr (tok.type == pattern::TokenType::Literal) {
+        constexpr std::string_view lit = kFormat.substr(tok.offset, tok.length);
+        if constexpr (!kStatic) {
+          if (line.size() - pos < lit.size())
+            return false;
+        }
+        if (std::memcmp(line.data() + pos, lit.data(), lit.size()) != 0)
+          return false;
+        end = pos + lit.size();
+      } else if constexpr (tok.type == pattern::TokenType::Date) {
+        end = pattern::matchDate(line, pos);
+        if (end == pattern::npos)
+          return false;
+        captures.date = line.substr(pos, end - pos);
+      } else if constexpr (tok.type == pattern::TokenType::Time) {
+        end = pattern::matchTime(line, pos);
+        if (end == pattern::npos)
+          return false;
+        captures.time = line.substr(pos, end - pos);
+      } else if constexpr (tok.type == pattern::TokenType::Level) {
+        end = pattern::matchLevel(line, pos);
+        if (end == pattern::npos)
+          return false;
+        if (captures.wanted.level) {
+          captures.entry.level =
+              pattern::levelFromString(line.substr(pos, end - pos));
+        }
+      } else {
+        // Message: to the end of the line or up to the closing literal
+        constexpr size_t kTail =
+            I + 1 < kTokenCount ? kTokens[I + 1].length : 0;
+        if (line.size() - pos < kTail)
+          return false;
+        end = line.size() - kTail;
+        // Checked even when not projected, as in PatternLogParser
+        const std::string_view message = line.substr(pos, end - pos);
+        if (pattern::hasLineTerminator(message))
+          return false;
+        if (captures.wanted.message)
+          captures.entry.message = message;
+      }
+
+      return matchFrom<I + 1>(line, end, captures);
+    }
+  }
+};
+
+} // namespace loganalyzer
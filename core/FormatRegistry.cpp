@@ -0,0 +1,47 @@
+#include "FormatRegistry.h"
+#include "PatternLogParser.h"
+#include "StandardLogParser.h"
+
+namespace loganalyzer {
+
+FormatRegistry::FormatRegistry() {
+  // Main service log formats. Add a line here to specialize another one.
+  add<"[%D %T] [%L] %M">();
+  add<"%D %T [%L] %M">();
+  add<"%D %T %L %M">();
+}
+
+FormatRegistry &FormatRegistry::instance() {
+  static FormatRegistry registry;
+  return registry;
+}
+
+std::unique_ptr<ILogParser>
+FormatRegistry::createParser(const std::string &pattern) {
+  if (pattern.empty()) {
+    return std::make_unique<StandardLogParser>();
+  }
+  if (auto parser = instance().createSpecialized(pattern)) {
+    return parser;
+  }
+  return std::make_unique<PatternLogParser>(pattern);
+}
+
+std::unique_ptr<ILogParser>
+FormatRegistry::createSpecialized(std::string_view pattern) const {
+  for (const auto &entry : entries_) {
+    if (entry.pattern == pattern)
+      return entry.factory();
+  }
+  return nullptr;
+}
+
+bool FormatRegistry::contains(std::string_view pattern) const {
+  for (const auto &entry : entries_) {
+    if (entry.pattern == pattern)
+      return true;
+  }
+  return false;
+}
+
+} // namespace loganalyzer
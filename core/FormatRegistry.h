@@ -0,0 +1,51 @@
+#pragma once
+
+#include "FormatParser.h"
+#include "ILogParser.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Maps runtime pattern strings to compile-time FormatParser
+ * instantiations.
+ *
+ * The frequently used service formats are registered in FormatRegistry.cpp;
+ * any other pattern falls back to the runtime PatternLogParser.
+ */
+class FormatRegistry {
+public:
+  using Factory = std::unique_ptr<ILogParser> (*)();
+
+  static FormatRegistry &instance();
+
+  // Builds the parser for an AnalysisContext: StandardLogParser for an empty
+  // pattern, a registered FormatParser if available, else PatternLogParser.
+  static std::unique_ptr<ILogParser> createParser(const std::string &pattern);
+
+  // Returns nullptr if no specialization is registered for the pattern
+  std::unique_ptr<ILogParser> createSpecialized(std::string_view pattern) const;
+
+  bool contains(std::string_view pattern) const;
+
+  template <FixedString Format> void add() {
+    entries_.push_back({FormatParser<Format>::format(), [] {
+                          return std::unique_ptr<ILogParser>(
+                              std::make_unique<FormatParser<Format>>());
+                        }});
+  }
+
+private:
+  FormatRegistry();
+
+  struct Entry {
+    std::string_view pattern;
+    Factory factory;
+  };
+  std::vector<Entry> entries_;
+};
+
+} // namespace loganalyzer
@@ -1,16 +1,50 @@
 #pragma once
 
+#include "ParseFields.h"
 #include "ParseResult.h"
+#include "ParsedBatch.h"
+#include <cstdint>
+#include <span>
 #include <string_view>
 
 namespace loganalyzer {
 
+// Per-parser counters, collected by the Pipeline after a run
+struct ParserStats {
+  uint64_t timestampCacheHits = 0;
+  uint64_t timestampCacheMisses = 0;
+};
+
 class ILogParser {
 public:
   virtual ~ILogParser() = default;
 
-  // Thread-safe parse method
+  // Parsers may keep per-instance caches between calls: use one instance
+  // per worker thread
   virtual ParseResult parse(std::string_view line, size_t lineNumber) const = 0;
+
+  // Parse up to ParsedBatch::kCapacity lines with one virtual call.
+  // Parsers override this with a tight loop; the default calls parse().
+  virtual void parseBatch(std::span<const std::string_view> lines,
+                          ParsedBatch &out) const {
+    out.size = lines.size();
+    for (size_t i = 0; i < lines.size(); ++i) {
+      ParseResult result = parse(lines[i], i + 1);
+      if (const auto *entry = std::get_if<LogEntry>(&result))
+        out.setEntry(i, lines[i], *entry);
+      else
+        out.setError(i, std::get<ParseError>(result).code);
+    }
+  }
+
+  virtual ParserStats stats() const { return {}; }
+
+  // Restrict parse() to the fields the caller needs (default: all)
+  void setFields(const ParseFields &fields) { fields_ = fields; }
+  const ParseFields &fields() const { return fields_; }
+
+protected:
+  ParseFields fields_ = ParseFields::all();
 };
 
 } // namespace loganalyzer
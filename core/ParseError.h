@@ -1,14 +1,17 @@
 #pragma once
 
-#include <string>
+#include <cstddef>
+#include <string_view>
 
 namespace loganalyzer {
 
 enum class ParseErrorCode { BadFormat, BadTimestamp, BadLevel, MissingMessage };
 
+// Like LogEntry, only views the input: valid while the parsed buffer is.
+// Copy rawLine if it has to outlive the run (see AnalysisResult samples).
 struct ParseError {
   ParseErrorCode code;
-  std::string rawLine;
+  std::string_view rawLine;
   size_t lineNumber;
 };
 
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace loganalyzer {
+
+// LogEntry fields a caller actually uses (projection pushdown).
+// A parser leaves unrequested fields default-initialized and does not
+// validate them, so e.g. a bad timestamp is not reported as BadTimestamp
+// when the timestamp is not requested. rawLine is always set.
+struct ParseFields {
+  bool timestamp = false;
+  bool level = false;
+  bool message = false;
+
+  static constexpr ParseFields all() { return {true, true, true}; }
+
+  constexpr ParseFields &operator|=(const ParseFields &other) {
+    timestamp |= other.timestamp;
+    level |= other.level;
+    message |= other.message;
+    return *this;
+  }
+};
+
+} // namespace loganalyzer
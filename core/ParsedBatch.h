@@ -0,0 +1,58 @@
+#pragma once
+
+#include "LogEntry.h"
+#include "ParseError.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace loganalyzer {
+
+/**
+ * @brief Struct-of-arrays output of ILogParser::parseBatch.
+ *
+ * Holds the parsed fields of up to kCapacity consecutive lines. Entry i
+ * belongs to lines[i] of the batch that was parsed; fields the parser was
+ * not asked for (see ParseFields) stay default.
+ */
+struct ParsedBatch {
+  static constexpr size_t kCapacity = 256;
+
+  size_t size = 0;
+
+  std::array<bool, kCapacity> valid;
+  std::array<ParseErrorCode, kCapacity> errors; // Only where !valid
+  std::array<Timestamp, kCapacity> timestamps;
+  std::array<LogLevel, kCapacity> levels;
+  std::array<uint32_t, kCapacity> messageOffsets; // Relative to line start
+  std::array<uint32_t, kCapacity> messageLengths;
+
+  void setEntry(size_t i, std::string_view line, const LogEntry &entry) {
+    valid[i] = true;
+    timestamps[i] = entry.ts;
+    levels[i] = entry.level;
+    setMessage(i, line, entry.message);
+  }
+
+  void setError(size_t i, ParseErrorCode code) {
+    valid[i] = false;
+    errors[i] = code;
+  }
+
+  // message must be empty or a view into line
+  void setMessage(size_t i, std::string_view line, std::string_view message) {
+    messageOffsets[i] = message.empty()
+                            ? 0
+                            : static_cast<uint32_t>(message.data() - line.data());
+    messageLengths[i] = static_cast<uint32_t>(message.size());
+  }
+
+  // Rebuild the LogEntry of a valid line for the analyzers
+  LogEntry entry(size_t i, std::string_view line) const {
+    return {timestamps[i], levels[i], line,
+            line.substr(messageOffsets[i], messageLengths[i])};
+  }
+};
+
+} // namespace loganalyzer
@@ -1,6 +1,5 @@
 #include "PatternLogParser.h"
 #include <iostream>
-#include <sstream>
 
 namespace loganalyzer {
 
@@ -55,6 +54,16 @@ void PatternLogParser::compilePattern(const std::string &pattern) {
   }
 
   regexString_ = rx;
+
+  // Prefer the compiled token matcher; std::regex is only built for
+  // patterns that need backtracking.
+  tokens_.clear();
+  pattern::tokenize(pattern,
+                    [this](const pattern::Token &t) { tokens_.push_back(t); });
+  compiled_ = pattern::isDeterministic(tokens_.data(), tokens_.size(), pattern);
+  if (compiled_)
+    return;
+
   try {
     regex_ = std::regex(rx);
   } catch (const std::regex_error &e) {
@@ -64,59 +73,142 @@ void PatternLogParser::compilePattern(const std::string &pattern) {
   }
 }
 
-static LogLevel stringToLevel(std::string_view s) {
-  if (s.find("ERROR") != std::string_view::npos ||
-      s.find("ERR") != std::string_view::npos)
-    return LogLevel::ERROR;
-  if (s.find("WARN") != std::string_view::npos)
-    return LogLevel::WARNING;
-  return LogLevel::INFO;
-}
-
 ParseResult PatternLogParser::parse(std::string_view line,
                                     size_t lineNumber) const {
-  std::string lineStr(line);
-  std::smatch matches;
+  LogEntry entry{};
+  entry.rawLine = line;
 
-  if (std::regex_match(lineStr, matches, regex_)) {
-    LogEntry entry;
-    entry.rawLine = line;
-
-    std::string_view dateSv, timeSv;
+  bool matched =
+      compiled_ ? matchCompiled(line, entry) : matchRegex(line, entry);
+  if (matched)
+    return entry;
 
-    for (size_t i = 0; i < groupMapping_.size(); ++i) {
-      size_t matchIdx = i + 1;
-      auto start = matches.position(matchIdx);
-      auto len = matches.length(matchIdx);
-      std::string_view val = line.substr(start, len);
+  return ParseError{ParseErrorCode::BadFormat, line, lineNumber};
+}
 
-      switch (groupMapping_[i]) {
-      case FieldType::Date:
-        dateSv = val;
-        break;
-      case FieldType::Time:
-        timeSv = val;
-        break;
-      case FieldType::Level:
-        entry.level = stringToLevel(val);
-        break;
-      case FieldType::Message:
-        entry.message = val;
-        break;
+void PatternLogParser::parseBatch(std::span<const std::string_view> lines,
+                                  ParsedBatch &out) const {
+  out.size = lines.size();
+
+  // Matcher choice hoisted out of the line loop
+  auto run = [&](auto match) {
+    for (size_t i = 0; i < lines.size(); ++i) {
+      LogEntry entry{};
+      if (match(lines[i], entry)) {
+        out.setEntry(i, lines[i], entry);
+      } else {
+        out.setError(i, ParseErrorCode::BadFormat);
       }
     }
+  };
+
+  if (compiled_) {
+    run([this](std::string_view l, LogEntry &e) { return matchCompiled(l, e); });
+  } else {
+    run([this](std::string_view l, LogEntry &e) { return matchRegex(l, e); });
+  }
+}
 
-    if (!dateSv.empty() && !timeSv.empty()) {
-      std::string combined = std::string(dateSv) + " " + std::string(timeSv);
-      Timestamp::parse(combined, entry.ts);
-    } else if (!timeSv.empty()) {
-      Timestamp::parse(timeSv, entry.ts);
+bool PatternLogParser::matchCompiled(std::string_view line,
+                                     LogEntry &entry) const {
+  std::string_view dateSv, timeSv;
+  size_t pos = 0;
+
+  for (size_t i = 0; i < tokens_.size(); ++i) {
+    const pattern::Token &tok = tokens_[i];
+    size_t end = pos;
+
+    switch (tok.type) {
+    case pattern::TokenType::Literal: {
+      std::string_view lit(pattern_.data() + tok.offset, tok.length);
+      if (!line.substr(pos).starts_with(lit))
+        return false;
+      end = pos + lit.size();
+      break;
+    }
+    case pattern::TokenType::Date:
+      end = pattern::matchDate(line, pos);
+      if (end == pattern::npos)
+        return false;
+      dateSv = line.substr(pos, end - pos);
+      break;
+    case pattern::TokenType::Time:
+      end = pattern::matchTime(line, pos);
+      if (end == pattern::npos)
+        return false;
+      timeSv = line.substr(pos, end - pos);
+      break;
+    case pattern::TokenType::Level:
+      end = pattern::matchLevel(line, pos);
+      if (end == pattern::npos)
+        return false;
+      if (fields_.level)
+        entry.level = pattern::levelFromString(line.substr(pos, end - pos));
+      break;
+    case pattern::TokenType::Message: {
+      // Runs to the end of the line, or up to a closing literal
+      size_t tail = i + 1 < tokens_.size() ? tokens_[i + 1].length : 0;
+      if (line.size() - pos < tail)
+        return false;
+      end = line.size() - tail;
+      // Checked even when not projected, so validity matches the regex
+      const std::string_view message = line.substr(pos, end - pos);
+      if (pattern::hasLineTerminator(message))
+        return false;
+      if (fields_.message)
+        entry.message = message;
+      break;
+    }
     }
+    pos = end;
+  }
 
-    return entry;
+  if (pos != line.size())
+    return false;
+
+  if (fields_.timestamp && !dateSv.empty() && !timeSv.empty()) {
+    pattern::parseDateTime(dateSv, timeSv, entry.ts);
+  }
+  return true;
+}
+
+bool PatternLogParser::matchRegex(std::string_view line,
+                                  LogEntry &entry) const {
+  std::cmatch matches;
+  if (!std::regex_match(line.data(), line.data() + line.size(), matches,
+                        regex_))
+    return false;
+
+  std::string_view dateSv, timeSv;
+
+  for (size_t i = 0; i < groupMapping_.size(); ++i) {
+    size_t matchIdx = i + 1;
+    auto start = matches.position(matchIdx);
+    auto len = matches.length(matchIdx);
+    std::string_view val = line.substr(start, len);
+
+    switch (groupMapping_[i]) {
+    case FieldType::Date:
+      dateSv = val;
+      break;
+    case FieldType::Time:
+      timeSv = val;
+      break;
+    case FieldType::Level:
+      if (fields_.level)
+        entry.level = pattern::levelFromString(val);
+      break;
+    case FieldType::Message:
+      if (fields_.message)
+        entry.message = val;
+      break;
+    }
   }
 
-  return ParseError{ParseErrorCode::BadFormat, std::string(line), lineNumber};
+  if (fields_.timestamp && !dateSv.empty() && !timeSv.empty()) {
+    pattern::parseDateTime(dateSv, timeSv, entry.ts);
+  }
+  return true;
 }
 
 } // namespace loganalyzer
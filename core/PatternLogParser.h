@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ILogParser.h"
+#include "PatternTokens.h"
 #include <map>
 #include <regex>
 #include <string>
@@ -20,6 +21,10 @@ namespace loganalyzer {
  *
  * Example: "[%D %T] [%L] %M" registers as a regex for lines like "[2023-10-27
  * 10:00:00] [INFO] Hello"
+ *
+ * Patterns that can be matched left to right without backtracking are
+ * compiled into a token matcher that works on the string_view directly and
+ * allocates nothing per line. Only the remaining patterns use std::regex.
  */
 class PatternLogParser : public ILogParser {
 public:
@@ -27,18 +32,29 @@ public:
 
   ParseResult parse(std::string_view line, size_t lineNumber) const override;
 
+  void parseBatch(std::span<const std::string_view> lines,
+                  ParsedBatch &out) const override;
+
   const std::string &getPattern() const { return pattern_; }
   const std::string &getRegexString() const { return regexString_; }
 
+  // True if lines are matched by the compiled token matcher
+  bool isCompiled() const { return compiled_; }
+
 private:
   enum class FieldType { Date, Time, Level, Message };
 
   void compilePattern(const std::string &pattern);
+  bool matchCompiled(std::string_view line, LogEntry &entry) const;
+  bool matchRegex(std::string_view line, LogEntry &entry) const;
 
   std::string pattern_;
   std::string regexString_;
   std::regex regex_;
   std::vector<FieldType> groupMapping_;
+
+  std::vector<pattern::Token> tokens_;
+  bool compiled_ = false;
 };
 
 } // namespace loganalyzer
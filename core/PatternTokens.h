@@ -0,0 +1,213 @@
+#pragma once
+
+#include "LogLevel.h"
+#include "Timestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace loganalyzer::pattern {
+
+// Building blocks shared by the compiled PatternLogParser matcher and the
+// compile-time FormatParser.
+// Each field matcher mirrors the regex fragment PatternLogParser generates
+// for its token, so the compiled path accepts exactly the same lines.
+
+enum class TokenType : uint8_t { Literal, Date, Time, Level, Message };
+
+struct Token {
+  TokenType type = TokenType::Literal;
+  uint32_t offset = 0; // Literal: slice of the pattern string
+  uint32_t length = 0;
+};
+
+constexpr size_t npos = std::string_view::npos;
+
+// Splits a pattern into field tokens and literal runs. Unknown %x sequences
+// and a trailing '%' stay literal, as in the regex translation.
+template <typename Emit>
+constexpr void tokenize(std::string_view pattern, Emit &&emit) {
+  size_t literalStart = 0;
+  auto flushLiteral = [&](size_t end) {
+    if (end > literalStart) {
+      emit(Token{TokenType::Literal, static_cast<uint32_t>(literalStart),
+                 static_cast<uint32_t>(end - literalStart)});
+    }
+  };
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] != '%' || i + 1 >= pattern.size())
+      continue;
+
+    TokenType type;
+    switch (pattern[i + 1]) {
+    case 'D':
+      type = TokenType::Date;
+      break;
+    case 'T':
+      type = TokenType::Time;
+      break;
+    case 'L':
+      type = TokenType::Level;
+      break;
+    case 'M':
+      type = TokenType::Message;
+      break;
+    default:
+      continue; // Literal '%'
+    }
+
+    flushLiteral(i);
+    emit(Token{type, static_cast<uint32_t>(i), 2});
+    literalStart = i + 2;
+    i++;
+  }
+  flushLiteral(pattern.size());
+}
+
+constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// \w in ECMAScript regex
+constexpr bool isWordChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || isDigit(c) ||
+         c == '_';
+}
+
+// True if s contains a character '.' does not match in ECMAScript regex
+inline bool hasLineTerminator(std::string_view s) {
+  return !s.empty() && (std::memchr(s.data(), '\n', s.size()) != nullptr ||
+                        std::memchr(s.data(), '\r', s.size()) != nullptr);
+}
+
+// A greedy field followed by `next` needs regex backtracking when `next` can
+// start with a character the field itself would consume.
+constexpr bool canStartWithWordChar(const Token &next,
+                                    std::string_view pattern) {
+  if (next.type == TokenType::Literal)
+    return isWordChar(pattern[next.offset]);
+  return next.type != TokenType::Message;
+}
+
+// True when a left-to-right, no-backtracking match gives the same result as
+// the regex. Patterns failing this check keep using std::regex.
+constexpr bool isDeterministic(const Token *tokens, size_t count,
+                               std::string_view pattern) {
+  for (size_t i = 0; i < count; ++i) {
+    const bool last = i + 1 == count;
+    switch (tokens[i].type) {
+    case TokenType::Time:
+      // Optional "(\.\d+)" fraction
+      if (!last) {
+        const Token &next = tokens[i + 1];
+        if (next.type == TokenType::Literal) {
+          char c = pattern[next.offset];
+          if (c == '.' || isDigit(c))
+            return false;
+        } else if (next.type != TokenType::Message) {
+          return false;
+        }
+      }
+      break;
+    case TokenType::Level:
+      if (!last && canStartWithWordChar(tokens[i + 1], pattern))
+        return false;
+      break;
+    case TokenType::Message:
+      // ".*" may only be followed by the end or by a closing literal
+      if (!last && !(i + 2 == count &&
+                     tokens[i + 1].type == TokenType::Literal))
+        return false;
+      break;
+    default:
+      break;
+    }
+  }
+  return true;
+}
+
+// Field matchers: return the end of the match starting at pos, or npos.
+
+// \d{4}[-/]\d{2}[-/]\d{2}
+constexpr size_t matchDate(std::string_view s, size_t pos) {
+  if (s.size() - pos < 10)
+    return npos;
+  const char *p = s.data() + pos;
+  for (size_t i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+    if (!isDigit(p[i]))
+      return npos;
+  }
+  if ((p[4] != '-' && p[4] != '/') || (p[7] != '-' && p[7] != '/'))
+    return npos;
+  return pos + 10;
+}
+
+// \d{2}:\d{2}:\d{2}(?:\.\d+)?
+constexpr size_t matchTime(std::string_view s, size_t pos) {
+  if (s.size() - pos < 8)
+    return npos;
+  const char *p = s.data() + pos;
+  for (size_t i : {0, 1, 3, 4, 6, 7}) {
+    if (!isDigit(p[i]))
+      return npos;
+  }
+  if (p[2] != ':' || p[5] != ':')
+    return npos;
+
+  size_t end = pos + 8;
+  if (end + 1 < s.size() && s[end] == '.' && isDigit(s[end + 1])) {
+    end += 2;
+    while (end < s.size() && isDigit(s[end]))
+      end++;
+  }
+  return end;
+}
+
+// \w+
+constexpr size_t matchLevel(std::string_view s, size_t pos) {
+  size_t end = pos;
+  while (end < s.size() && isWordChar(s[end]))
+    end++;
+  return end == pos ? npos : end;
+}
+
+// Loose level mapping used by configurable patterns
+constexpr LogLevel levelFromString(std::string_view s) {
+  // Exact names first; substring search only for unusual spellings
+  if (s == "INFO")
+    return LogLevel::INFO;
+  if (s == "ERROR")
+    return LogLevel::ERROR;
+  if (s == "WARNING" || s == "WARN")
+    return LogLevel::WARNING;
+
+  if (s.find("ERR") != std::string_view::npos)
+    return LogLevel::ERROR;
+  if (s.find("WARN") != std::string_view::npos)
+    return LogLevel::WARNING;
+  return LogLevel::INFO;
+}
+
+// Joins matched %D and %T fields into a Timestamp without allocating.
+// Fractional seconds are dropped and '/' date separators are accepted.
+inline bool parseDateTime(std::string_view date, std::string_view time,
+                          Timestamp &out) {
+  if (date.size() != 10 || time.size() < 8)
+    return false;
+
+  // Common case "YYYY-MM-DD HH:MM:SS" is contiguous in the line
+  if (time.data() == date.data() + 11 && date.data()[10] == ' ' &&
+      date[4] == '-' && date[7] == '-') {
+    return Timestamp::parse(std::string_view(date.data(), 19), out);
+  }
+
+  char buf[19];
+  for (size_t i = 0; i < 10; ++i)
+    buf[i] = date[i] == '/' ? '-' : date[i];
+  buf[10] = ' ';
+  for (size_t i = 0; i < 8; ++i)
+    buf[11 + i] = time[i];
+  return Timestamp::parse(std::string_view(buf, sizeof(buf)), out);
+}
+
+} // namespace loganalyzer::pattern
@@ -9,77 +9,114 @@ constexpr size_t TIMESTAMP_LENGTH = 19;  // YYYY-MM-DD HH:MM:SS
 constexpr size_t TIMESTAMP_MIN_END = 20; // Length of [ + TIMESTAMP + ]
 } // namespace
 
-ParseResult StandardLogParser::parse(std::string_view sv,
-                                     size_t lineNumber) const {
+inline bool StandardLogParser::parseLine(std::string_view sv, LogEntry &entry,
+                                         ParseErrorCode &error) const {
   // Expected format: [YYYY-MM-DD HH:MM:SS] [LEVEL] message
 
   // Minimum length check
   if (sv.length() < MIN_LINE_LENGTH) {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
   // Check opening bracket for timestamp
   if (sv[0] != '[') {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
   // Find closing bracket for timestamp (more robust than fixed position)
   size_t tsEnd = sv.find(']', 1);
   if (tsEnd == std::string_view::npos || tsEnd < TIMESTAMP_MIN_END) {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
   // Extract timestamp (zero-copy with string_view)
   std::string_view tsView = sv.substr(1, tsEnd - 1);
   if (tsView.length() != TIMESTAMP_LENGTH) {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
-  // Parse timestamp
+  // Parse timestamp (only if requested)
   Timestamp ts;
-  if (!Timestamp::parse(tsView, ts)) {
-    return ParseError{ParseErrorCode::BadTimestamp, std::string(sv),
-                      lineNumber};
+  if (fields_.timestamp && !tsCache_.parse(tsView, ts)) {
+    error = ParseErrorCode::BadTimestamp;
+    return false;
   }
 
   // Check for space and opening bracket for level
   if (tsEnd + 2 >= sv.length() || sv[tsEnd + 1] != ' ' ||
       sv[tsEnd + 2] != '[') {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
   // Find closing bracket for level
   size_t levelStart = tsEnd + 3;
   size_t levelEnd = sv.find(']', levelStart);
   if (levelEnd == std::string_view::npos) {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
   // Extract and parse level (zero-copy)
   std::string_view levelView = sv.substr(levelStart, levelEnd - levelStart);
-  LogLevel level;
-  if (!parseLogLevel(levelView, level)) {
-    return ParseError{ParseErrorCode::BadLevel, std::string(sv), lineNumber};
+  LogLevel level = LogLevel::INFO;
+  if (fields_.level && !parseLogLevel(levelView, level)) {
+    error = ParseErrorCode::BadLevel;
+    return false;
   }
 
   // Check for space after level bracket
   if (levelEnd + 1 >= sv.length()) {
-    return ParseError{ParseErrorCode::MissingMessage, std::string(sv),
-                      lineNumber};
+    error = ParseErrorCode::MissingMessage;
+    return false;
   }
 
   if (sv[levelEnd + 1] != ' ') {
-    return ParseError{ParseErrorCode::BadFormat, std::string(sv), lineNumber};
+    error = ParseErrorCode::BadFormat;
+    return false;
   }
 
   // Extract message (zero-copy)
   size_t messageStart = levelEnd + 2;
   std::string_view message;
-  if (messageStart < sv.length()) {
+  if (fields_.message && messageStart < sv.length()) {
     message = sv.substr(messageStart);
   }
 
-  return LogEntry{ts, level, sv, message};
+  entry = LogEntry{ts, level, sv, message};
+  return true;
+}
+
+ParseResult StandardLogParser::parse(std::string_view sv,
+                                     size_t lineNumber) const {
+  LogEntry entry;
+  ParseErrorCode error;
+  if (!parseLine(sv, entry, error)) {
+    return ParseError{error, sv, lineNumber};
+  }
+  return entry;
+}
+
+void StandardLogParser::parseBatch(std::span<const std::string_view> lines,
+                                   ParsedBatch &out) const {
+  out.size = lines.size();
+  for (size_t i = 0; i < lines.size(); ++i) {
+    LogEntry entry;
+    ParseErrorCode error;
+    if (parseLine(lines[i], entry, error)) {
+      out.setEntry(i, lines[i], entry);
+    } else {
+      out.setError(i, error);
+    }
+  }
+}
+
+ParserStats StandardLogParser::stats() const {
+  return {tsCache_.hits(), tsCache_.misses()};
 }
 
 bool StandardLogParser::parseLogLevel(std::string_view str, LogLevel &out) {
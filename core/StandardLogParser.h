@@ -2,6 +2,7 @@
 
 #include "ILogParser.h"
 #include "ParseResult.h"
+#include "TimestampCache.h"
 #include <string>
 #include <string_view>
 
@@ -9,12 +10,23 @@ namespace loganalyzer {
 
 class StandardLogParser : public ILogParser {
 public:
-  // Stateless parser: parse single line
+  // Parse single line; remembers the last timestamp prefix between calls
   // Expected format: [YYYY-MM-DD HH:MM:SS] [LEVEL] message
   ParseResult parse(std::string_view line, size_t lineNumber) const override;
 
+  void parseBatch(std::span<const std::string_view> lines,
+                  ParsedBatch &out) const override;
+
+  ParserStats stats() const override;
+
 private:
+  // Shared by parse() and parseBatch()
+  bool parseLine(std::string_view sv, LogEntry &entry,
+                 ParseErrorCode &error) const;
+
   static bool parseLogLevel(std::string_view str, LogLevel &out);
+
+  mutable TimestampCache tsCache_;
 };
 
 } // namespace loganalyzer
@@ -1,12 +1,110 @@
 #include "Timestamp.h"
+#include <bit>
 #include <charconv>
+#include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
 
 namespace loganalyzer {
 
+namespace {
+
+// Little-endian word holding 8 characters
+constexpr uint64_t packChars(const char (&s)[9]) {
+  uint64_t word = 0;
+  for (int i = 7; i >= 0; --i)
+    word = (word << 8) | static_cast<uint8_t>(s[i]);
+  return word;
+}
+
+// Lane masks for one 8-byte window: 'd' = digit, anything else = separator
+constexpr uint64_t laneMask(const char (&layout)[9], bool digits,
+                            uint8_t value) {
+  uint64_t word = 0;
+  for (int i = 7; i >= 0; --i)
+    word = (word << 8) | (((layout[i] == 'd') == digits) ? value : 0);
+  return word;
+}
+
+// "YYYY-MM-DD HH:MM:SS" is covered by three 8-byte loads at 0, 8 and 11
+struct Window {
+  uint64_t expected;  // '0' in digit lanes, the separator elsewhere
+  uint64_t digitHigh; // 0xF0 in digit lanes
+  uint64_t digitAdd;  // 0x06 in digit lanes
+  uint64_t separator; // 0xFF in separator lanes
+};
+
+constexpr Window makeWindow(const char (&text)[9], const char (&layout)[9]) {
+  return {packChars(text), laneMask(layout, true, 0xF0),
+          laneMask(layout, true, 0x06), laneMask(layout, false, 0xFF)};
+}
+
+constexpr Window kDateWindow = makeWindow("0000-00-", "dddd-dd-");
+constexpr Window kMidWindow = makeWindow("00 00:00", "dd dd:dd");
+constexpr Window kTimeWindow = makeWindow("00:00:00", "dd:dd:dd");
+
+// XOR with the expected text leaves 0..9 in valid digit lanes and 0 in
+// valid separator lanes. Returns nonzero bits for any invalid lane.
+inline uint64_t checkWindow(uint64_t word, const Window &w, uint64_t &digits) {
+  uint64_t x = word ^ w.expected;
+  digits = x;
+  return ((x | (x + w.digitAdd)) & w.digitHigh) | (x & w.separator);
+}
+
+// Byte i of the result holds the two-digit number formed by lanes i, i+1
+inline uint64_t digitPairs(uint64_t digits) {
+  return digits * 10 + (digits >> 8);
+}
+
+inline int lane(uint64_t word, int i) {
+  return static_cast<int>((word >> (i * 8)) & 0xFF);
+}
+
+inline uint64_t load64(const char *p) {
+  uint64_t word;
+  std::memcpy(&word, p, 8);
+  return word;
+}
+
+} // namespace
+
 bool Timestamp::parse(std::string_view str, Timestamp &out) {
+  if constexpr (std::endian::native != std::endian::little) {
+    return parseScalar(str, out);
+  }
+
+  if (str.length() != 19)
+    return false;
+
+  uint64_t d0, d1, d2;
+  uint64_t bad = checkWindow(load64(str.data()), kDateWindow, d0) |
+                 checkWindow(load64(str.data() + 8), kMidWindow, d1) |
+                 checkWindow(load64(str.data() + 11), kTimeWindow, d2);
+  if (bad != 0)
+    return false;
+
+  uint64_t p0 = digitPairs(d0);
+  uint64_t p1 = digitPairs(d1);
+  uint64_t p2 = digitPairs(d2);
+
+  int year = lane(p0, 0) * 100 + lane(p0, 2);
+  int month = lane(p0, 5);
+  int day = lane(p1, 0);
+  int hour = lane(p1, 3);
+  int minute = lane(p1, 6);
+  int second = lane(p2, 6);
+
+  bool inRange = (static_cast<unsigned>(month - 1) < 12u) & (hour < 24) &
+                 (minute < 60) & (second < 60);
+  if (!inRange || !isValidDate(year, month, day))
+    return false;
+
+  out = Timestamp(year, month, day, hour, minute, second);
+  return true;
+}
+
+bool Timestamp::parseScalar(std::string_view str, Timestamp &out) {
   // Expected format: YYYY-MM-DD HH:MM:SS (19 chars)
   if (str.length() != 19)
     return false;
@@ -23,33 +121,35 @@ bool Timestamp::parse(std::string_view str, Timestamp &out) {
     return ec == std::errc{} && ptr == sv.data() + sv.size();
   };
 
-  if (!parse_int(str.substr(0, 4), out.year))
+  int year, month, day, hour, minute, second;
+  if (!parse_int(str.substr(0, 4), year))
     return false;
-  if (!parse_int(str.substr(5, 2), out.month))
+  if (!parse_int(str.substr(5, 2), month))
     return false;
-  if (!parse_int(str.substr(8, 2), out.day))
+  if (!parse_int(str.substr(8, 2), day))
     return false;
-  if (!parse_int(str.substr(11, 2), out.hour))
+  if (!parse_int(str.substr(11, 2), hour))
     return false;
-  if (!parse_int(str.substr(14, 2), out.minute))
+  if (!parse_int(str.substr(14, 2), minute))
     return false;
-  if (!parse_int(str.substr(17, 2), out.second))
+  if (!parse_int(str.substr(17, 2), second))
     return false;
 
   // Validate ranges
-  if (out.month < 1 || out.month > 12)
+  if (month < 1 || month > 12)
     return false;
-  if (out.hour < 0 || out.hour > 23)
+  if (hour < 0 || hour > 23)
     return false;
-  if (out.minute < 0 || out.minute > 59)
+  if (minute < 0 || minute > 59)
     return false;
-  if (out.second < 0 || out.second > 59)
+  if (second < 0 || second > 59)
     return false;
 
   // Validate calendar logic (31 feb, 30 feb, etc.)
-  if (!isValidDate(out.year, out.month, out.day))
+  if (!isValidDate(year, month, day))
     return false;
 
+  out = Timestamp(year, month, day, hour, minute, second);
   return true;
 }
 
@@ -73,42 +173,34 @@ bool Timestamp::isValidDate(int year, int month, int day) {
   return day <= maxDays;
 }
 
-bool Timestamp::operator<(const Timestamp &other) const {
-  if (year != other.year)
-    return year < other.year;
-  if (month != other.month)
-    return month < other.month;
-  if (day != other.day)
-    return day < other.day;
-  if (hour != other.hour)
-    return hour < other.hour;
-  if (minute != other.minute)
-    return minute < other.minute;
-  return second < other.second;
+// Inverse of daysFromCivil (H. Hinnant's civil_from_days)
+Timestamp::Civil Timestamp::civil() const {
+  int64_t z = floorDiv(seconds_, kSecondsPerDay) + 719468;
+  int64_t era = floorDiv(z, 146097);
+  int64_t doe = z - era * 146097;
+  int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t mp = (5 * doy + 2) / 153;
+  int day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  int year = static_cast<int>(yoe + era * 400 + (month <= 2));
+  return {year, month, day};
 }
 
-bool Timestamp::operator>(const Timestamp &other) const {
-  return other < *this;
-}
-
-bool Timestamp::operator==(const Timestamp &other) const {
-  return year == other.year && month == other.month && day == other.day &&
-         hour == other.hour && minute == other.minute && second == other.second;
-}
-
-bool Timestamp::operator<=(const Timestamp &other) const {
-  return !(other < *this);
-}
-
-bool Timestamp::operator>=(const Timestamp &other) const {
-  return !(*this < other);
-}
+int Timestamp::year() const { return civil().year; }
+int Timestamp::month() const { return civil().month; }
+int Timestamp::day() const { return civil().day; }
 
 std::string Timestamp::toString() const {
+  if (!isValid())
+    return "0000-00-00 00:00:00";
+
+  Civil date = civil();
   std::ostringstream oss;
-  oss << std::setfill('0') << std::setw(4) << year << '-' << std::setw(2)
-      << month << '-' << std::setw(2) << day << ' ' << std::setw(2) << hour
-      << ':' << std::setw(2) << minute << ':' << std::setw(2) << second;
+  oss << std::setfill('0') << std::setw(4) << date.year << '-' << std::setw(2)
+      << date.month << '-' << std::setw(2) << date.day << ' ' << std::setw(2)
+      << hour() << ':' << std::setw(2) << minute() << ':' << std::setw(2)
+      << second();
   return oss.str();
 }
 
@@ -1,36 +1,111 @@
 #pragma once
 
+#include <compare>
+#include <cstdint>
 #include <ctime>
+#include <limits>
 #include <string>
 #include <string_view>
 
 namespace loganalyzer {
 
-struct Timestamp {
-  int year;
-  int month;
-  int day;
-  int hour;
-  int minute;
-  int second;
+/**
+ * @brief Wall-clock time with one-second resolution, stored as seconds since
+ * 1970-01-01 00:00:00 (proleptic Gregorian calendar, no time zone).
+ *
+ * The calendar conversion happens once, in parse(). Comparisons, minute
+ * buckets, hour of day and day of week are plain integer operations.
+ * A default-constructed Timestamp is invalid and orders before every valid
+ * one.
+ */
+class Timestamp {
+public:
+  constexpr Timestamp() = default;
+
+  // Fields are not validated; use parse() for untrusted input
+  constexpr Timestamp(int year, int month, int day, int hour = 0,
+                      int minute = 0, int second = 0)
+      : seconds_(daysFromCivil(year, month, day) * kSecondsPerDay +
+                 hour * 3600 + minute * 60 + second) {}
+
+  static constexpr Timestamp fromEpochSeconds(int64_t seconds) {
+    Timestamp ts;
+    ts.seconds_ = seconds;
+    return ts;
+  }
 
   // Parse from YYYY-MM-DD HH:MM:SS (strict, with leading zeros)
   // Now accepts string_view for zero-copy parsing
+  // SWAR fast path: validates all 19 bytes with one mask test
   static bool parse(std::string_view str, Timestamp &out);
 
-  // Comparison operators
-  bool operator<(const Timestamp &other) const;
-  bool operator>(const Timestamp &other) const;
-  bool operator==(const Timestamp &other) const;
-  bool operator<=(const Timestamp &other) const;
-  bool operator>=(const Timestamp &other) const;
+  // Portable field-by-field reference implementation of parse()
+  static bool parseScalar(std::string_view str, Timestamp &out);
+
+  constexpr bool isValid() const { return seconds_ != kInvalid; }
+  constexpr int64_t epochSeconds() const { return seconds_; }
+
+  // Start of the containing minute, in epoch seconds
+  constexpr int64_t minuteBucket() const {
+    return seconds_ - floorMod(seconds_, 60);
+  }
+
+  // 0 = Sunday ... 6 = Saturday
+  constexpr int dayOfWeek() const {
+    // 1970-01-01 was a Thursday
+    int64_t days = floorDiv(seconds_, kSecondsPerDay);
+    return static_cast<int>(floorMod(days + 4, 7));
+  }
+
+  constexpr int hourOfDay() const {
+    return static_cast<int>(floorMod(seconds_, kSecondsPerDay) / 3600);
+  }
+
+  // Calendar fields, converted back on demand
+  int year() const;
+  int month() const;
+  int day() const;
+  int hour() const { return hourOfDay(); }
+  int minute() const { return static_cast<int>(floorMod(seconds_, 3600) / 60); }
+  int second() const { return static_cast<int>(floorMod(seconds_, 60)); }
+
+  constexpr auto operator<=>(const Timestamp &other) const = default;
 
   // Convert to string for display
   std::string toString() const;
 
 private:
+  static constexpr int64_t kInvalid = std::numeric_limits<int64_t>::min();
+  static constexpr int64_t kSecondsPerDay = 86400;
+
+  static constexpr int64_t floorDiv(int64_t a, int64_t b) {
+    return a / b - (a % b < 0);
+  }
+  static constexpr int64_t floorMod(int64_t a, int64_t b) {
+    return a - floorDiv(a, b) * b;
+  }
+
+  // Days since 1970-01-01 (H. Hinnant's days_from_civil)
+  static constexpr int64_t daysFromCivil(int year, int month, int day) {
+    int64_t y = static_cast<int64_t>(year) - (month <= 2);
+    int64_t era = floorDiv(y, 400);
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+  }
+
+  struct Civil {
+    int year;
+    int month;
+    int day;
+  };
+  Civil civil() const;
+
   // Validate calendar logic (days per month, leap year)
   static bool isValidDate(int year, int month, int day);
+
+  int64_t seconds_ = kInvalid;
 };
 
 } // namespace loganalyzer
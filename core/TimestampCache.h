@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Timestamp.h"
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace loganalyzer {
+
+/**
+ * @brief Remembers the last parsed "YYYY-MM-DD HH:MM" prefix.
+ *
+ * Consecutive log lines nearly always fall in the same minute. When the
+ * first 16 bytes match the previous successful parse byte for byte, only the
+ * two seconds digits are parsed and calendar validation is skipped; anything
+ * else falls back to Timestamp::parse.
+ *
+ * Not thread-safe: keep one instance per worker.
+ */
+class TimestampCache {
+public:
+  // Same contract as Timestamp::parse
+  bool parse(std::string_view str, Timestamp &out) {
+    if (str.size() == 19 && valid_ &&
+        std::memcmp(str.data(), prefix_, kPrefixLength) == 0 &&
+        str[16] == ':') {
+      unsigned tens = static_cast<unsigned char>(str[17]) - '0';
+      unsigned ones = static_cast<unsigned char>(str[18]) - '0';
+      if (tens < 6 && ones < 10) {
+        ++hits_;
+        out = Timestamp::fromEpochSeconds(minuteStart_ + tens * 10 + ones);
+        return true;
+      }
+    }
+
+    ++misses_;
+    if (!Timestamp::parse(str, out))
+      return false;
+
+    std::memcpy(prefix_, str.data(), kPrefixLength);
+    minuteStart_ = out.minuteBucket();
+    valid_ = true;
+    return true;
+  }
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+private:
+  static constexpr size_t kPrefixLength = 16; // "YYYY-MM-DD HH:MM"
+
+  char prefix_[kPrefixLength] = {};
+  int64_t minuteStart_ = 0;
+  bool valid_ = false;
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+} // namespace loganalyzer
@@ -1,4 +1,5 @@
 #include "GuiController.h"
+#include "../analysis/BoundedTopErrorAnalyzer.h"
 #include "../core/ConfigManager.h"
 #include "../external/IconsFontAwesome6.h"
 #include "../external/imgui/imgui.h"
@@ -11,6 +12,10 @@
 
 namespace loganalyzer {
 
+namespace {
+constexpr std::chrono::seconds kFollowInterval{2};
+} // namespace
+
 GuiController::GuiController()
     : hasResults_(false), showError_(false), showAbout_(false),
       shouldClose_(false), isAnalyzing_(false), analysisProgress_(0.0f),
@@ -165,6 +170,14 @@ void GuiController::render() {
   if (isAnalyzing_) {
     checkAnalysisComplete();
   }
+  if (analyzeQueued_ && !isAnalyzing_) {
+    analyzeQueued_ = false;
+    startAnalysis();
+  } else if (followMode_ && hasResults_ && !isAnalyzing_ &&
+             std::chrono::steady_clock::now() - lastAnalysis_ >=
+                 kFollowInterval) {
+    startAnalysis(true);
+  }
 
   ImGui::SetNextWindowSize(ImVec2(900, 700), ImGuiCond_FirstUseEver);
 
@@ -207,7 +220,7 @@ void GuiController::render() {
         renderFilters();
         renderAnalyzeButton();
 
-        if (isAnalyzing_) {
+        if (isAnalyzing_ && !isRefreshing_) {
           renderProgressBar();
         }
 
@@ -218,7 +231,7 @@ void GuiController::render() {
       }
 
       if (ImGui::BeginTabItem(ICON_FA_FILE_LINES " Log Viewer")) {
-        if (!logFile_ || !logFile_->isOpen()) {
+        if ((!logFile_ || !logFile_->isOpen()) && !gzipIndex_) {
           if (ImGui::Button(ICON_FA_FOLDER_OPEN
                             " Open Current File for Viewing")) {
             openLogForViewing(inputPath_);
@@ -321,6 +334,20 @@ void GuiController::renderFilters() {
     ImGui::Unindent();
   }
 
+  ImGui::Checkbox("Follow File", &followMode_);
+  if (followMode_) {
+    ImGui::SameLine();
+    ImGui::TextDisabled("Re-analyzes appended lines every %llds",
+                        static_cast<long long>(kFollowInterval.count()));
+  }
+
+  ImGui::Checkbox("Bounded Top Errors", &boundedTopErrors_);
+  if (boundedTopErrors_) {
+    ImGui::SameLine();
+    ImGui::TextDisabled("Approximate counts in fixed memory, for logs with "
+                        "mostly unique messages");
+  }
+
   ImGui::Checkbox("Configurable Parser", &useCustomParser_);
   if (useCustomParser_) {
     ImGui::Indent();
@@ -335,14 +362,19 @@ void GuiController::renderFilters() {
 }
 
 void GuiController::renderAnalyzeButton() {
-  if (isAnalyzing_) {
+  if (isAnalyzing_ && !isRefreshing_) {
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.3f, 0.3f, 1.0f));
     if (ImGui::Button(ICON_FA_XMARK " Cancel Analysis", ImVec2(-1, 50))) {
       cancelRequested_ = true;
     }
     ImGui::PopStyleColor();
-  } else {
-    if (ImGui::Button(ICON_FA_ROCKET " Analyze Log", ImVec2(-1, 50))) {
+  } else if (ImGui::Button(ICON_FA_ROCKET " Analyze Log", ImVec2(-1, 50))) {
+    if (isAnalyzing_) {
+      // Stop the background follow refresh; the new analysis (with
+      // progress and Cancel) starts once it has returned
+      cancelRequested_ = true;
+      analyzeQueued_ = true;
+    } else {
       startAnalysis();
     }
   }
@@ -357,50 +389,69 @@ void GuiController::renderProgressBar() {
   ImGui::Spacing();
 }
 
-void GuiController::startAnalysis() {
-  currentRequest_.inputPath = inputPath_;
+AppRequest GuiController::buildRequest() const {
+  AppRequest request;
+  request.inputPath = inputPath_;
 
   if (useTimeFilter_) {
     Timestamp from, to;
     if (Timestamp::parse(fromTimestamp_, from)) {
-      currentRequest_.fromTimestamp = from;
+      request.fromTimestamp = from;
     }
     if (Timestamp::parse(toTimestamp_, to)) {
-      currentRequest_.toTimestamp = to;
+      request.toTimestamp = to;
     }
   }
 
   if (useKeyword_ && !keyword_.empty()) {
-    currentRequest_.keyword = keyword_;
+    request.keyword = keyword_;
   }
 
+  request.topErrorCapacity =
+      boundedTopErrors_ ? BoundedTopErrorAnalyzer::kDefaultCapacity : 0;
+
   if (useCustomParser_ && !customPattern_.empty()) {
-    currentRequest_.customPattern = customPattern_;
-  } else {
-    currentRequest_.customPattern = "";
+    request.customPattern = customPattern_;
   }
 
-  // Save Config
-  ConfigManager::instance().setString("inputPath", inputPath_);
-  ConfigManager::instance().save();
+  // Workers watch the cancel flag directly
+  request.stopToken = &cancelRequested_;
+  return request;
+}
+
+void GuiController::startAnalysis(bool refresh) {
+  // A refresh repeats the submitted request, so Application::follow only
+  // analyzes appended lines
+  if (!refresh) {
+    currentRequest_ = buildRequest();
+    ConfigManager::instance().setString("inputPath", inputPath_);
+    ConfigManager::instance().save();
+  }
 
   isAnalyzing_ = true;
+  isRefreshing_ = refresh;
   analysisProgress_ = 0.0f;
   cancelRequested_ = false;
   analysisComplete_ = false;
-  hasResults_ = false;
+  if (!refresh) {
+    hasResults_ = false;
+  }
 
-  analysisThread_ = std::thread([this]() {
+  // In follow mode the Application keeps the session, so only lines
+  // appended since the previous run are analyzed
+  const bool follow = followMode_;
+  analysisThread_ = std::thread([this, follow]() {
     auto callback = [this](float progress) -> bool {
       analysisProgress_ = progress;
       return !cancelRequested_.load();
     };
 
-    AppResult result = app_.run(currentRequest_, callback);
+    AppResult result = follow ? app_.follow(currentRequest_, callback)
+                              : app_.run(currentRequest_, callback);
 
     {
       std::lock_guard<std::mutex> lock(resultMutex_);
-      lastResult_ = result;
+      pendingResult_ = std::move(result);
     }
 
     analysisComplete_ = true;
@@ -413,8 +464,13 @@ void GuiController::checkAnalysisComplete() {
       analysisThread_.join();
     }
     isAnalyzing_ = false;
+    isRefreshing_ = false;
+    lastAnalysis_ = std::chrono::steady_clock::now();
 
-    std::lock_guard<std::mutex> lock(resultMutex_);
+    {
+      std::lock_guard<std::mutex> lock(resultMutex_);
+      lastResult_ = std::move(pendingResult_);
+    }
     if (lastResult_.wasCancelled) {
       hasResults_ = false;
       showError_ = false;
@@ -589,19 +645,28 @@ void GuiController::renderResults() {
     ImGui::Unindent();
   }
 
+  // Fixed ID after ###, so the header keeps its state when K changes
+  const std::string topErrorsLabel =
+      ICON_FA_FIRE " Top " + std::to_string(result.topErrorLimit) +
+      " ERROR Messages###top_errors_header";
   if (!result.topErrors.empty() &&
-      ImGui::CollapsingHeader(ICON_FA_FIRE " Top 10 ERROR Messages",
+      ImGui::CollapsingHeader(topErrorsLabel.c_str(),
                               ImGuiTreeNodeFlags_DefaultOpen)) {
     ImGui::Indent();
     struct ErrorRow {
       int rank;
       std::string message;
       uint64_t count;
+      uint64_t bound; // Bounded mode: count may be this much too high
     };
     std::vector<ErrorRow> errorRows;
-    int rank = 1;
-    for (const auto &[message, count] : result.topErrors)
-      errorRows.push_back({rank++, message, count});
+    for (size_t i = 0; i < result.topErrors.size(); ++i) {
+      const auto &[message, count] = result.topErrors[i];
+      errorRows.push_back({static_cast<int>(i) + 1, message, count,
+                           i < result.topErrorBounds.size()
+                               ? result.topErrorBounds[i]
+                               : 0});
+    }
     if (ImGui::BeginTable("top_errors", 3,
                           ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
                               ImGuiTableFlags_Sortable)) {
@@ -609,10 +674,11 @@ void GuiController::renderResults() {
           "#", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoSort,
           30.0f);
       ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_DefaultSort);
+      // Wider for the count ranges of bounded mode
       ImGui::TableSetupColumn("Count",
                               ImGuiTableColumnFlags_PreferSortDescending |
                                   ImGuiTableColumnFlags_WidthFixed,
-                              60.0f);
+                              result.topErrorBounds.empty() ? 60.0f : 120.0f);
       ImGui::TableHeadersRow();
       if (ImGuiTableSortSpecs *sorts_specs = ImGui::TableGetSortSpecs()) {
         if (sorts_specs->SpecsDirty) {
@@ -638,7 +704,11 @@ void GuiController::renderResults() {
         ImGui::TableNextColumn();
         ImGui::TextWrapped("%s", row.message.c_str());
         ImGui::TableNextColumn();
-        ImGui::Text("%llu", row.count);
+        if (row.bound > 0) {
+          ImGui::Text("%llu-%llu", row.count - row.bound, row.count);
+        } else {
+          ImGui::Text("%llu", row.count);
+        }
       }
       ImGui::EndTable();
     }
@@ -678,8 +748,8 @@ void GuiController::renderTimeline() {
                        IM_COL32(255, 255, 255, 30), 8.0f);
 
     // Find min/max time and max counts
-    uint64_t minTime = timeline.front().timestamp;
-    uint64_t maxTime = timeline.back().timestamp;
+    int64_t minTime = timeline.front().timestamp;
+    int64_t maxTime = timeline.back().timestamp;
 
     // Safety: ensure span > 0
     if (maxTime <= minTime)
@@ -702,36 +772,8 @@ void GuiController::renderTimeline() {
     // Since we might have thousands of minutes, we need to bin them visually if
     // width < buckets For simplicity, we just draw lines.
 
-    for (const auto &b : timeline) {
-      // Normalize Time 0..1
-      // Note: timeKey is YYYYMMDDHHMM. This is monotonic but NOT linear (gaps
-      // between hour/day). For true linearity, we'd need parse to Unix. But for
-      // simple visualization, let's treat it as pseudo-linear or just
-      // index-based if sorted? "timeline" vector is sorted by timeKey (if we
-      // merged correctly? pipeline insert makes it semi-sorted but chunk
-      // artifacts exist) Let's assume sorted for now.
-
-      // Actually, we didn't sort timeline in merge. Let's do a sort here if
-      // needed, or rely on visual density. Better: Just iterate.
-
-      // X position based on value relative to min/max key?
-      // 202601051030 vs 202601051031 is +1.
-      // 202601051059 vs 202601051100 is +41.
-      // This distorts x-axis.
-      // Fallback: Use index in the vector if we assume it's somewhat
-      // contiguous? Or better: Revert to 0..N indices for "Minutes Available".
-      // Since we don't have unix conversion handy in this scope without
-      // helpers.
-
-      // REVISION: Draw indices.
-      /*
-         If we have gaps, they won't show. That's acceptable for "Event
-         Timeline".
-      */
-
-      // Linear Index Approximation
-    }
-
+    // Buckets are sorted Unix minutes; bars are placed by index, so minutes
+    // without errors or warnings take no space.
     // Improved Approach: Just loop through indices 0..N
     size_t count = timeline.size();
     for (size_t i = 0; i < count; ++i) {
@@ -763,7 +805,9 @@ void GuiController::renderTimeline() {
       if (ImGui::IsMouseHoveringRect(ImVec2(x - 2, p.y),
                                      ImVec2(x + 2, p.y + height))) {
         ImGui::BeginTooltip();
-        ImGui::Text("Time: %llu", b.timestamp);
+        ImGui::Text(
+            "Time: %s",
+            Timestamp::fromEpochSeconds(b.timestamp).toString().c_str());
         ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "Errors: %u",
                            b.errorCount);
         ImGui::TextColored(ImVec4(1, 0.8f, 0.2f, 1), "Warnings: %u",
@@ -4,8 +4,10 @@
 #include "../app/AppResult.h"
 #include "../app/Application.h"
 #include "../core/Timestamp.h"
+#include "../io/GzipIndex.h"
 #include "../io/MemoryMappedFile.h"
 #include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <mutex>
 #include <optional>
@@ -44,8 +46,11 @@ private:
   // File picker helpers
   void updateFileList();
 
-  // Analysis thread management
-  void startAnalysis();
+  // Analysis thread management. A refresh re-submits the last request the
+  // user started, in follow mode, while the previous results stay on
+  // screen; edits to the widgets only apply on the next Analyze click.
+  void startAnalysis(bool refresh = false);
+  AppRequest buildRequest() const;
   void checkAnalysisComplete();
 
   // Progress callback for analysis
@@ -59,8 +64,9 @@ private:
   std::string keyword_;
 
   bool hasResults_;
-  AppResult lastResult_;
-  mutable std::mutex resultMutex_; // Protects shared result data
+  AppResult lastResult_;           // Owned by the UI thread
+  AppResult pendingResult_;        // Written by the analysis thread
+  mutable std::mutex resultMutex_; // Protects pendingResult_
 
   bool showError_;
   std::string errorMessage_;
@@ -76,10 +82,17 @@ private:
   std::atomic<bool> analysisComplete_;
   AppRequest currentRequest_;
 
+  // Follow mode: re-analyze appended lines every kFollowInterval
+  bool followMode_ = false;
+  bool isRefreshing_ = false;
+  bool analyzeQueued_ = false; // Clicked during a refresh; runs after it
+  std::chrono::steady_clock::time_point lastAnalysis_;
+
   // UI flags
   bool useTimeFilter_;
   bool useKeyword_;
   bool useCustomParser_;
+  bool boundedTopErrors_ = false; // Approximate top errors, fixed memory
   std::string customPattern_;
 
   // File Picker State
@@ -91,9 +104,12 @@ private:
 
   // Log Viewer
   void renderLogViewer();
+  void renderCompressedLog();
   std::unique_ptr<MemoryMappedFile> logFile_;
   std::vector<size_t> lineOffsets_; // Cache of line start positions
-  mutable std::mutex viewerMutex_;  // Protects logFile_ and lineOffsets_
+  std::unique_ptr<GzipIndex> gzipIndex_; // Used instead for .gz files
+  std::string viewerError_;              // Why the last file did not open
+  mutable std::mutex viewerMutex_; // Protects the four members above
   bool showLogViewer_;
   std::atomic<bool> isIndexing_;
   std::atomic<float> indexingProgress_;
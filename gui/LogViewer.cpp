@@ -1,9 +1,30 @@
 #include "../external/IconsFontAwesome6.h"
 #include "../external/imgui/imgui.h"
+#include "../io/Decompressor.h"
+#include "../io/LineScanner.h"
 #include "GuiController.h"
+#include <exception>
 
 namespace loganalyzer {
 
+namespace {
+// Line spans fetched per LineScanner batch while indexing
+constexpr size_t kIndexBatchSize = 1024;
+
+// Simple coloring based on content
+void renderLogLine(std::string_view line) {
+  ImVec4 color = ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
+  if (line.find("[ERROR]") != std::string::npos)
+    color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
+  else if (line.find("[WARNING]") != std::string::npos)
+    color = ImVec4(1.0f, 0.8f, 0.2f, 1.0f);
+  else if (line.find("[INFO]") != std::string::npos)
+    color = ImVec4(0.4f, 0.8f, 1.0f, 1.0f);
+
+  ImGui::TextColored(color, "%.*s", (int)line.length(), line.data());
+}
+} // namespace
+
 void GuiController::openLogForViewing(const std::string &path) {
   if (indexerThread_.joinable()) {
     // We don't want to block the UI, but we should ensure we don't leak
@@ -20,7 +41,49 @@ void GuiController::openLogForViewing(const std::string &path) {
 
 void GuiController::indexFileAsync(const std::string &path) {
   try {
-    auto file = std::make_unique<MemoryMappedFile>(path);
+    // Compressed logs: checkpoint index instead of a mapping, reused from
+    // disk when the file has not changed since it was built
+    Compression compression = Decompressor::detectFile(path);
+    if (compression == Compression::Gzip) {
+      auto index = std::make_unique<GzipIndex>();
+      bool loaded = false;
+      try {
+        loaded = index->load(path);
+      } catch (const std::exception &) {
+        // Unreadable index: build it again like a missing one
+      }
+      if (!loaded) {
+        if (index->build(path, [&](float p) { indexingProgress_ = p; })) {
+          index->save(); // Best effort; the directory may be read-only
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(viewerMutex_);
+      logFile_.reset();
+      lineOffsets_.clear();
+      if (index->checkpoints().empty()) {
+        viewerError_ = index->error();
+        gzipIndex_.reset();
+      } else {
+        viewerError_.clear();
+        gzipIndex_ = std::move(index);
+      }
+      isIndexing_ = false;
+      indexingProgress_ = 1.0f;
+      return;
+    }
+    if (compression != Compression::None) {
+      std::lock_guard<std::mutex> lock(viewerMutex_);
+      viewerError_ = std::string(Decompressor::name(compression)) +
+                     " files cannot be viewed; only gzip has random access";
+      isIndexing_ = false;
+      return;
+    }
+
+    // Scrolling jumps around: no readahead beyond the faulting page
+    auto file = std::make_unique<MemoryMappedFile>(
+        path,
+        MemoryMappedFile::Options{MemoryMappedFile::Access::Random});
     if (!file->isOpen()) {
       isIndexing_ = false;
       return;
@@ -35,27 +98,22 @@ void GuiController::indexFileAsync(const std::string &path) {
       size_t estimatedLines = data.size() / 120;
       localOffsets.reserve(estimatedLines + 100);
 
-      localOffsets.push_back(0);
-      size_t pos = 0;
+      LineScanner scanner(data);
+      LineSpan spans[kIndexBatchSize];
       size_t totalSize = data.size();
       size_t lastUpdatePos = 0;
+      size_t count;
+
+      while ((count = scanner.nextBatch(spans, kIndexBatchSize)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+          localOffsets.push_back(spans[i].begin);
+        }
 
-      while (true) {
-        pos = data.find('\n', pos);
-        if (pos == std::string_view::npos)
-          break;
-
-        pos++; // skip newline
-        if (pos < totalSize) {
-          localOffsets.push_back(pos);
-
-          // Update progress every 1MB of processed data roughly
-          if (pos - lastUpdatePos > 1024 * 1024) {
-            indexingProgress_ = (float)pos / (float)totalSize;
-            lastUpdatePos = pos;
-          }
-        } else {
-          break;
+        // Update progress every 1MB of processed data roughly
+        size_t pos = scanner.position();
+        if (pos - lastUpdatePos > 1024 * 1024) {
+          indexingProgress_ = (float)pos / (float)totalSize;
+          lastUpdatePos = pos;
         }
       }
     }
@@ -65,6 +123,8 @@ void GuiController::indexFileAsync(const std::string &path) {
       std::lock_guard<std::mutex> lock(viewerMutex_);
       lineOffsets_ = std::move(localOffsets);
       logFile_ = std::move(file);
+      gzipIndex_.reset();
+      viewerError_.clear();
     }
   } catch (...) {
     // Error
@@ -85,6 +145,16 @@ void GuiController::renderLogViewer() {
 
   std::lock_guard<std::mutex> lock(viewerMutex_);
 
+  if (!viewerError_.empty()) {
+    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s",
+                       viewerError_.c_str());
+  }
+
+  if (gzipIndex_) {
+    renderCompressedLog();
+    return;
+  }
+
   if (!logFile_ || !logFile_->isOpen()) {
     ImGui::TextDisabled("No log file loaded for viewing.");
     return;
@@ -111,18 +181,7 @@ void GuiController::renderLogViewer() {
       if (end > start && data[end - 1] == '\r')
         end--;
 
-      std::string_view line = data.substr(start, end - start);
-
-      // Simple coloring based on content
-      ImVec4 color = ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
-      if (line.find("[ERROR]") != std::string::npos)
-        color = ImVec4(1.0f, 0.4f, 0.4f, 1.0f);
-      else if (line.find("[WARNING]") != std::string::npos)
-        color = ImVec4(1.0f, 0.8f, 0.2f, 1.0f);
-      else if (line.find("[INFO]") != std::string::npos)
-        color = ImVec4(0.4f, 0.8f, 1.0f, 1.0f);
-
-      ImGui::TextColored(color, "%.*s", (int)line.length(), line.data());
+      renderLogLine(data.substr(start, end - start));
     }
   }
 
@@ -132,4 +191,34 @@ void GuiController::renderLogViewer() {
               lineOffsets_.size());
 }
 
+// Called with viewerMutex_ held. Only the lines the clipper shows are
+// inflated, starting from the nearest checkpoint.
+void GuiController::renderCompressedLog() {
+  ImGui::BeginChild("LogView", ImVec2(0, -30), true,
+                    ImGuiWindowFlags_HorizontalScrollbar);
+
+  ImGuiListClipper clipper;
+  clipper.Begin((int)gzipIndex_->lineCount());
+
+  std::vector<std::string_view> lines;
+  while (clipper.Step()) {
+    if (!gzipIndex_->readLines(clipper.DisplayStart,
+                               clipper.DisplayEnd - clipper.DisplayStart,
+                               lines)) {
+      ImGui::TextDisabled("%s", gzipIndex_->error().c_str());
+      break;
+    }
+    for (std::string_view line : lines) {
+      renderLogLine(line);
+    }
+  }
+
+  ImGui::EndChild();
+
+  ImGui::Text("Total Lines: %llu | View Mode: Read-Only (gzip, %zu "
+              "checkpoints)",
+              (unsigned long long)gzipIndex_->lineCount(),
+              gzipIndex_->checkpoints().size());
+}
+
 } // namespace loganalyzer
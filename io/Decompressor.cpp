@@ -0,0 +1,464 @@
+#include "Decompressor.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LOGANALYZER_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace loganalyzer {
+
+namespace {
+
+constexpr unsigned char kGzipMagic[] = {0x1f, 0x8b};
+constexpr unsigned char kZstdMagic[] = {0x28, 0xb5, 0x2f, 0xfd};
+
+bool startsWith(std::string_view data, const unsigned char *magic,
+                size_t size) {
+  return data.size() >= size && std::memcmp(data.data(), magic, size) == 0;
+}
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+
+uint32_t readLe16(std::string_view data, size_t pos) {
+  auto b = reinterpret_cast<const unsigned char *>(data.data() + pos);
+  return b[0] | (b[1] << 8);
+}
+
+uint32_t readLe32(std::string_view data, size_t pos) {
+  return readLe16(data, pos) | (readLe16(data, pos + 2) << 16);
+}
+
+// Smallest gzip member: 10 byte header, empty deflate block, 8 byte
+// trailer. Also enough to see a BGZF header.
+constexpr size_t kMinMemberSize = 18;
+
+// Output of one parallel batch; bounds memory like a stream block
+constexpr size_t kBatchBytes = 4 * 1024 * 1024;
+
+// BGZF members hold at most 64 KB; larger ones are inflated in order
+constexpr uint32_t kMaxBgzfOutput = 64 * 1024;
+
+/**
+ * @brief gzip, including concatenated members.
+ *
+ * A member whose header has a BGZF "BC" field states its compressed size,
+ * so the following members can be found without inflating this one. Runs
+ * of such members are inflated in parallel straight into place, by helper
+ * threads started on the first batch and kept for the whole input. Any
+ * other member goes through one streaming inflate.
+ */
+class GzipDecompressor final : public Decompressor {
+public:
+  explicit GzipDecompressor(unsigned threads)
+      : threads_(std::max(threads, 1u)) {}
+
+  ~GzipDecompressor() override {
+    {
+      std::lock_guard<std::mutex> lock(crewMutex_);
+      crewStopping_ = true;
+    }
+    crewWake_.notify_all();
+    for (auto &helper : helpers_)
+      helper.join();
+    if (streamReady_)
+      inflateEnd(&stream_);
+  }
+
+  size_t decompress(std::string_view &input, char *out,
+                    size_t size) override {
+    size_t written = 0;
+    while (written < size && !failed_) {
+      if (pendingPos_ < pending_.size()) {
+        size_t n = std::min(size - written, pending_.size() - pendingPos_);
+        std::memcpy(out + written, pending_.data() + pendingPos_, n);
+        pendingPos_ += n;
+        written += n;
+        continue;
+      }
+      if (inMember_) {
+        if (!inflateStream(input, out, size, written))
+          break;
+        continue;
+      }
+
+      // Between members. Some tools pad the file with zero bytes, which
+      // gzip ignores at the end of the input.
+      size_t zeros = 0;
+      while (zeros < input.size() && input[zeros] == '\0')
+        ++zeros;
+      input.remove_prefix(zeros);
+      padded_ = padded_ || zeros > 0;
+      if (input.empty())
+        break;
+      if (padded_) {
+        fail("Unexpected data after gzip padding");
+        break;
+      }
+      if (input.size() < kMinMemberSize)
+        break;
+      if (!startsWith(input, kGzipMagic, sizeof(kGzipMagic))) {
+        fail("Unexpected data after gzip member");
+        break;
+      }
+      switch (inflateBatch(input)) {
+      case Batch::Inflated:
+        continue;
+      case Batch::NeedInput:
+        return written;
+      case Batch::NotBgzf:
+        break;
+      }
+      if (!streamReady_) {
+        // 15 + 16: gzip wrapper with the largest window
+        if (inflateInit2(&stream_, 15 + 16) != Z_OK) {
+          fail("Cannot initialize zlib");
+          break;
+        }
+        streamReady_ = true;
+      } else {
+        inflateReset(&stream_);
+      }
+      inMember_ = true;
+    }
+    return written;
+  }
+
+  bool finished() const override {
+    return !inMember_ && pendingPos_ == pending_.size();
+  }
+  bool failed() const override { return failed_; }
+  const std::string &error() const override { return error_; }
+
+private:
+  enum class Batch { Inflated, NeedInput, NotBgzf };
+
+  struct Member {
+    std::string_view deflated; // Raw deflate data between header and trailer
+    uint32_t crc = 0;
+    uint32_t size = 0;   // Inflated size, from the trailer
+    size_t outOffset = 0; // Where it goes in pending_
+  };
+
+  void fail(std::string reason) {
+    failed_ = true;
+    error_ = std::move(reason);
+  }
+
+  // Streams the current member into out; false when it needs more input
+  bool inflateStream(std::string_view &input, char *out, size_t size,
+                     size_t &written) {
+    stream_.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+    stream_.avail_in = static_cast<uInt>(input.size());
+    stream_.next_out = reinterpret_cast<Bytef *>(out + written);
+    stream_.avail_out = static_cast<uInt>(size - written);
+
+    int rc = inflate(&stream_, Z_NO_FLUSH);
+    const size_t produced = (size - written) - stream_.avail_out;
+    input.remove_prefix(input.size() - stream_.avail_in);
+    written += produced;
+
+    if (rc == Z_STREAM_END) {
+      inMember_ = false;
+      return true;
+    }
+    if (rc == Z_BUF_ERROR)
+      return false; // No progress possible without more input
+    if (rc != Z_OK) {
+      fail(std::string("Corrupt gzip data: ") +
+           (stream_.msg ? stream_.msg : "inflate failed"));
+      return false;
+    }
+    return produced > 0 || !input.empty();
+  }
+
+  // Splits off the next member if it is a complete BGZF member
+  static Batch nextBgzfMember(std::string_view input, Member &member,
+                              size_t &memberSize) {
+    if (input.size() < kMinMemberSize ||
+        !startsWith(input, kGzipMagic, sizeof(kGzipMagic)))
+      return Batch::NotBgzf;
+    // Deflate, and FEXTRA as the only optional field
+    const auto flags = static_cast<unsigned char>(input[3]);
+    if (input[2] != 8 || (flags & ~1u) != 4)
+      return Batch::NotBgzf;
+
+    const size_t headerSize = 12 + readLe16(input, 10);
+    if (input.size() < headerSize)
+      return Batch::NeedInput;
+
+    // Find the "BC" subfield holding the member size minus one
+    size_t pos = 12;
+    while (pos + 4 <= headerSize) {
+      const size_t fieldSize = readLe16(input, pos + 2);
+      if (input[pos] == 'B' && input[pos + 1] == 'C' && fieldSize == 2 &&
+          pos + 6 <= headerSize) {
+        memberSize = readLe16(input, pos + 4) + 1;
+        if (memberSize < headerSize + 8)
+          return Batch::NotBgzf;
+        if (input.size() < memberSize)
+          return Batch::NeedInput;
+        member.deflated = input.substr(headerSize, memberSize - headerSize - 8);
+        member.crc = readLe32(input, memberSize - 8);
+        member.size = readLe32(input, memberSize - 4);
+        return member.size <= kMaxBgzfOutput ? Batch::Inflated
+                                             : Batch::NotBgzf;
+      }
+      pos += 4 + fieldSize;
+    }
+    return Batch::NotBgzf;
+  }
+
+  // Inflates the complete BGZF members at the front of input into
+  // pending_, up to kBatchBytes of output
+  Batch inflateBatch(std::string_view &input) {
+    std::vector<Member> members;
+    size_t consumed = 0;
+    size_t total = 0;
+    while (total < kBatchBytes) {
+      Member member;
+      size_t memberSize = 0;
+      Batch next = nextBgzfMember(input.substr(consumed), member, memberSize);
+      if (next != Batch::Inflated) {
+        if (members.empty())
+          return next;
+        break;
+      }
+      member.outOffset = total;
+      members.push_back(member);
+      consumed += memberSize;
+      total += member.size;
+    }
+
+    pending_.resize(total);
+    pendingPos_ = 0;
+
+    // Contiguous runs of members per thread; BGZF members are all about
+    // the same size
+    const size_t groups = std::min<size_t>(threads_, members.size());
+    std::atomic<bool> corrupt{false};
+    auto inflateGroup = [&](size_t group) {
+      z_stream zs{};
+      if (inflateInit2(&zs, -15) != Z_OK) {
+        corrupt = true;
+        return;
+      }
+      const size_t begin = members.size() * group / groups;
+      const size_t end = members.size() * (group + 1) / groups;
+      for (size_t m = begin; m < end && !corrupt; ++m) {
+        const Member &member = members[m];
+        Bytef empty;
+        Bytef *dest = member.size > 0
+                          ? reinterpret_cast<Bytef *>(pending_.data() +
+                                                      member.outOffset)
+                          : &empty;
+        inflateReset(&zs);
+        zs.next_in = reinterpret_cast<Bytef *>(
+            const_cast<char *>(member.deflated.data()));
+        zs.avail_in = static_cast<uInt>(member.deflated.size());
+        zs.next_out = dest;
+        zs.avail_out = member.size;
+        if (inflate(&zs, Z_FINISH) != Z_STREAM_END || zs.avail_out != 0 ||
+            crc32(0, dest, member.size) != member.crc) {
+          corrupt = true;
+        }
+      }
+      inflateEnd(&zs);
+    };
+
+    runGroups(groups, inflateGroup);
+
+    if (corrupt) {
+      pending_.clear();
+      fail("Corrupt gzip data: BGZF member does not inflate");
+      return Batch::Inflated;
+    }
+    input.remove_prefix(consumed);
+    return Batch::Inflated;
+  }
+
+  // Runs job(0) here and job(1..groups-1) on the helpers, then waits
+  void runGroups(size_t groups, const std::function<void(size_t)> &job) {
+    // New helpers wait for the generation about to be announced
+    while (helpers_.size() + 1 < groups) {
+      const size_t index = helpers_.size() + 1;
+      helpers_.emplace_back([this, index, seen = crewGeneration_] {
+        helperLoop(index, seen);
+      });
+    }
+    {
+      std::lock_guard<std::mutex> lock(crewMutex_);
+      crewJob_ = &job;
+      crewGroups_ = groups;
+      crewBusy_ = groups - 1;
+      ++crewGeneration_;
+    }
+    crewWake_.notify_all();
+    job(0);
+    std::unique_lock<std::mutex> lock(crewMutex_);
+    crewDone_.wait(lock, [&] { return crewBusy_ == 0; });
+  }
+
+  void helperLoop(size_t index, uint64_t seen) {
+    std::unique_lock<std::mutex> lock(crewMutex_);
+    while (true) {
+      crewWake_.wait(lock, [&] {
+        return crewStopping_ || crewGeneration_ != seen;
+      });
+      if (crewStopping_)
+        return;
+      seen = crewGeneration_;
+      if (index >= crewGroups_)
+        continue; // Not needed for this batch
+      const std::function<void(size_t)> &job = *crewJob_;
+      lock.unlock();
+      job(index);
+      lock.lock();
+      if (--crewBusy_ == 0)
+        crewDone_.notify_one();
+    }
+  }
+
+  unsigned threads_;
+  z_stream stream_{};
+  bool streamReady_ = false;
+  bool inMember_ = false; // Partway through a streamed member
+
+  std::vector<char> pending_; // Inflated BGZF batch not yet returned
+  size_t pendingPos_ = 0;
+  bool padded_ = false; // Zero bytes seen after the last member
+
+  // Helper threads for BGZF batches, at most threads_ - 1
+  std::vector<std::thread> helpers_;
+  std::mutex crewMutex_;
+  std::condition_variable crewWake_;
+  std::condition_variable crewDone_;
+  const std::function<void(size_t)> *crewJob_ = nullptr;
+  size_t crewGroups_ = 0;
+  size_t crewBusy_ = 0; // Helper groups of this batch still running
+  uint64_t crewGeneration_ = 0;
+  bool crewStopping_ = false;
+
+  bool failed_ = false;
+  std::string error_;
+};
+
+#endif // LOGANALYZER_HAVE_ZLIB
+
+#ifdef LOGANALYZER_HAVE_ZSTD
+
+// zstd, including concatenated frames
+class ZstdDecompressor final : public Decompressor {
+public:
+  ZstdDecompressor() : context_(ZSTD_createDCtx()) {
+    if (!context_)
+      fail("Cannot initialize zstd");
+  }
+  ~ZstdDecompressor() override { ZSTD_freeDCtx(context_); }
+
+  size_t decompress(std::string_view &input, char *out,
+                    size_t size) override {
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    ZSTD_outBuffer output{out, size, 0};
+    while (!failed_ && output.pos < output.size) {
+      const size_t before = in.pos + output.pos;
+      size_t rc = ZSTD_decompressStream(context_, &output, &in);
+      if (ZSTD_isError(rc)) {
+        fail(std::string("Corrupt zstd data: ") + ZSTD_getErrorName(rc));
+        break;
+      }
+      frameDone_ = rc == 0;
+      // Output left over means everything decodable so far was flushed
+      if (in.pos == in.size || in.pos + output.pos == before)
+        break;
+    }
+    input.remove_prefix(in.pos);
+    return output.pos;
+  }
+
+  bool finished() const override { return frameDone_; }
+  bool failed() const override { return failed_; }
+  const std::string &error() const override { return error_; }
+
+private:
+  void fail(std::string reason) {
+    failed_ = true;
+    error_ = std::move(reason);
+  }
+
+  ZSTD_DCtx *context_;
+  bool frameDone_ = false;
+  bool failed_ = false;
+  std::string error_;
+};
+
+#endif // LOGANALYZER_HAVE_ZSTD
+
+} // namespace
+
+Compression Decompressor::detect(std::string_view head) {
+  if (startsWith(head, kGzipMagic, sizeof(kGzipMagic)))
+    return Compression::Gzip;
+  if (startsWith(head, kZstdMagic, sizeof(kZstdMagic)))
+    return Compression::Zstd;
+  return Compression::None;
+}
+
+Compression Decompressor::detectFile(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return Compression::None;
+  char head[4];
+  ssize_t n = ::read(fd, head, sizeof(head));
+  ::close(fd);
+  return n > 0 ? detect({head, static_cast<size_t>(n)}) : Compression::None;
+}
+
+const char *Decompressor::name(Compression type) {
+  switch (type) {
+  case Compression::Gzip:
+    return "gzip";
+  case Compression::Zstd:
+    return "zstd";
+  case Compression::None:
+    break;
+  }
+  return "uncompressed";
+}
+
+std::unique_ptr<Decompressor> Decompressor::create(Compression type,
+                                                   unsigned threads) {
+  switch (type) {
+  case Compression::Gzip:
+#ifdef LOGANALYZER_HAVE_ZLIB
+    return std::make_unique<GzipDecompressor>(threads);
+#else
+    break;
+#endif
+  case Compression::Zstd:
+#ifdef LOGANALYZER_HAVE_ZSTD
+    return std::make_unique<ZstdDecompressor>();
+#else
+    break;
+#endif
+  case Compression::None:
+    break;
+  }
+  (void)threads;
+  return nullptr;
+}
+
+} // namespace loganalyzer
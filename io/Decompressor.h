@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace loganalyzer {
+
+enum class Compression { None, Gzip, Zstd };
+
+/**
+ * @brief Incremental decompression of gzip or zstd input.
+ *
+ * Fed by StreamReader as raw bytes arrive, so memory stays bounded and no
+ * temporary file is written. Concatenated gzip members and zstd frames are
+ * decompressed back to back. Gzip members that record their compressed
+ * size (BGZF, as written by bgzip) are inflated in parallel on up to
+ * threads threads; other members have to be inflated in order.
+ *
+ * gzip needs zlib (LOGANALYZER_HAVE_ZLIB), zstd needs libzstd
+ * (LOGANALYZER_HAVE_ZSTD).
+ */
+class Decompressor {
+public:
+  // Format of input starting with head; needs 4 bytes to tell
+  static Compression detect(std::string_view head);
+  // Reads the first bytes of a regular file; None if it cannot be read
+  static Compression detectFile(const std::string &path);
+  static const char *name(Compression type);
+
+  // nullptr if support for type was not compiled in
+  static std::unique_ptr<Decompressor> create(Compression type,
+                                              unsigned threads = 1);
+
+  virtual ~Decompressor() = default;
+
+  // Decompresses from the front of input into out, advancing input past
+  // what was consumed. Returns the bytes written; 0 means more input is
+  // needed (or failed()).
+  virtual size_t decompress(std::string_view &input, char *out,
+                            size_t size) = 0;
+
+  // True if everything fed so far forms complete members or frames and all
+  // output has been returned: the input may end here
+  virtual bool finished() const = 0;
+  // Corrupt input; set with a reason in error()
+  virtual bool failed() const = 0;
+  virtual const std::string &error() const = 0;
+};
+
+} // namespace loganalyzer
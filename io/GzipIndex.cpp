@@ -0,0 +1,410 @@
+#include "GzipIndex.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace loganalyzer {
+
+namespace {
+
+// Deflate looks back at most this far
+constexpr size_t kWindowSize = 32 * 1024;
+
+// Input handed to zlib per call; avail_in is 32-bit
+constexpr size_t kInputStep = 1024 * 1024;
+
+// Version 2: modification time in nanoseconds
+constexpr char kIndexMagic[8] = {'L', 'A', 'G', 'Z', 'I', 'D', 'X', '2'};
+
+template <typename T> void writeValue(std::ostream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> bool readValue(std::istream &in, T &value) {
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+} // namespace
+
+bool GzipIndex::statFile(uint64_t &fileSize, int64_t &mtime) const {
+  struct stat sb;
+  if (::stat(path_.c_str(), &sb) == -1)
+    return false;
+  fileSize = static_cast<uint64_t>(sb.st_size);
+  // Nanoseconds: a rewrite within the same second still invalidates
+  mtime = static_cast<int64_t>(sb.st_mtim.tv_sec) * 1'000'000'000 +
+          static_cast<int64_t>(sb.st_mtim.tv_nsec);
+  return true;
+}
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+
+bool GzipIndex::build(const std::string &path,
+                      const std::function<void(float)> &progress) {
+  *this = GzipIndex{};
+  path_ = path;
+  file_ = std::make_unique<MemoryMappedFile>(path);
+  if (!file_->isOpen()) {
+    error_ = "Cannot open file: " + path;
+    return false;
+  }
+  const auto *data = reinterpret_cast<const Bytef *>(file_->data());
+  const size_t size = file_->size();
+
+  z_stream zs{};
+  if (inflateInit2(&zs, 15 + 16) != Z_OK) {
+    error_ = "Cannot initialize zlib";
+    return false;
+  }
+  zs.next_in = const_cast<Bytef *>(data);
+
+  std::vector<unsigned char> buffer(64 * 1024);
+  std::vector<unsigned char> recent; // At least the last kWindowSize bytes
+  uint64_t out = 0;
+  uint64_t newlines = 0;
+  unsigned char last = '\n';
+  uint64_t lastProgress = 0;
+
+  auto addCheckpoint = [&](bool memberStart, int bits) {
+    Checkpoint cp;
+    cp.out = out;
+    cp.in = static_cast<uint64_t>(zs.next_in - data);
+    cp.lineStart = last == '\n';
+    cp.firstLine = newlines + (cp.lineStart ? 0 : 1);
+    cp.bits = bits;
+    cp.memberStart = memberStart;
+    if (!memberStart) {
+      size_t keep = std::min(recent.size(), kWindowSize);
+      cp.window.assign(recent.end() - keep, recent.end());
+    }
+    checkpoints_.push_back(std::move(cp));
+  };
+  addCheckpoint(true, 0);
+
+  bool ok = true;
+  while (true) {
+    const size_t pos = static_cast<size_t>(zs.next_in - data);
+    if (zs.avail_in == 0)
+      zs.avail_in = static_cast<uInt>(std::min(kInputStep, size - pos));
+
+    zs.next_out = buffer.data();
+    zs.avail_out = static_cast<uInt>(buffer.size());
+    // Z_BLOCK: return at every deflate block boundary
+    int rc = inflate(&zs, Z_BLOCK);
+    const size_t produced = buffer.size() - zs.avail_out;
+
+    if (produced > 0) {
+      newlines += std::count(buffer.begin(), buffer.begin() + produced, '\n');
+      last = buffer[produced - 1];
+      out += produced;
+      recent.insert(recent.end(), buffer.begin(), buffer.begin() + produced);
+      if (recent.size() > 2 * kWindowSize)
+        recent.erase(recent.begin(), recent.end() - kWindowSize);
+    }
+
+    if (rc == Z_STREAM_END) {
+      const size_t next = static_cast<size_t>(zs.next_in - data);
+      // Zero padding after the last member ends the input, as in gzip
+      if (std::all_of(data + next, data + size,
+                      [](Bytef b) { return b == 0; }))
+        break;
+      if (size - next < 2 || data[next] != 0x1f || data[next + 1] != 0x8b) {
+        error_ = "Unexpected data after gzip member";
+        ok = false;
+        break;
+      }
+      inflateReset(&zs);
+      if (out - checkpoints_.back().out >= kSpacing)
+        addCheckpoint(true, 0);
+      continue;
+    }
+    if (rc == Z_BUF_ERROR && zs.avail_in == 0 &&
+        static_cast<size_t>(zs.next_in - data) == size) {
+      error_ = "Truncated gzip file";
+      ok = false;
+      break;
+    }
+    if (rc != Z_OK && rc != Z_BUF_ERROR) {
+      error_ = std::string("Corrupt gzip data: ") +
+               (zs.msg ? zs.msg : "inflate failed");
+      ok = false;
+      break;
+    }
+
+    // Block boundary (bit 7), not after the last block (bit 6)
+    if ((zs.data_type & 128) && !(zs.data_type & 64) &&
+        out - checkpoints_.back().out >= kSpacing) {
+      addCheckpoint(false, zs.data_type & 7);
+    }
+
+    const size_t read = static_cast<size_t>(zs.next_in - data);
+    if (progress && read - lastProgress >= 4 * kInputStep) {
+      progress(static_cast<float>(read) / static_cast<float>(size));
+      lastProgress = read;
+    }
+  }
+  inflateEnd(&zs);
+
+  if (!ok) {
+    checkpoints_.clear();
+    return false;
+  }
+  size_ = out;
+  lineCount_ = newlines + (out > 0 && last != '\n' ? 1 : 0);
+  return true;
+}
+
+bool GzipIndex::inflateFrom(
+    size_t c, const std::function<bool(const char *, size_t)> &sink) {
+  const Checkpoint &cp = checkpoints_[c];
+  const auto *data = reinterpret_cast<const Bytef *>(file_->data());
+  const size_t size = file_->size();
+
+  // Mid-member checkpoints continue raw deflate data
+  bool raw = !cp.memberStart;
+  z_stream zs{};
+  if (inflateInit2(&zs, raw ? -15 : 15 + 16) != Z_OK) {
+    error_ = "Cannot initialize zlib";
+    return false;
+  }
+  if (raw) {
+    if (cp.bits > 0)
+      inflatePrime(&zs, cp.bits, data[cp.in - 1] >> (8 - cp.bits));
+    inflateSetDictionary(&zs, cp.window.data(),
+                         static_cast<uInt>(cp.window.size()));
+  }
+  zs.next_in = const_cast<Bytef *>(data + cp.in);
+
+  std::vector<char> buffer(64 * 1024);
+  bool ok = true;
+  while (true) {
+    size_t pos = static_cast<size_t>(zs.next_in - data);
+    if (zs.avail_in == 0)
+      zs.avail_in = static_cast<uInt>(std::min(kInputStep, size - pos));
+    zs.next_out = reinterpret_cast<Bytef *>(buffer.data());
+    zs.avail_out = static_cast<uInt>(buffer.size());
+    int rc = inflate(&zs, Z_NO_FLUSH);
+    const size_t produced = buffer.size() - zs.avail_out;
+    if (produced > 0 && !sink(buffer.data(), produced))
+      break;
+
+    if (rc == Z_STREAM_END) {
+      // Raw mode stops before the trailer; gzip mode has read it
+      pos = static_cast<size_t>(zs.next_in - data) + (raw ? 8 : 0);
+      if (pos >= size)
+        break;
+      inflateReset2(&zs, 15 + 16);
+      raw = false;
+      zs.next_in = const_cast<Bytef *>(data + pos);
+      zs.avail_in = 0;
+      continue;
+    }
+    if (rc != Z_OK &&
+        !(rc == Z_BUF_ERROR &&
+          static_cast<size_t>(zs.next_in - data) < size)) {
+      error_ = "Cannot inflate gzip data at checkpoint";
+      ok = false;
+      break;
+    }
+  }
+  inflateEnd(&zs);
+  return ok;
+}
+
+#else
+
+bool GzipIndex::build(const std::string &path,
+                      const std::function<void(float)> &) {
+  *this = GzipIndex{};
+  path_ = path;
+  error_ = "gzip support is not built in";
+  return false;
+}
+
+bool GzipIndex::inflateFrom(
+    size_t, const std::function<bool(const char *, size_t)> &) {
+  error_ = "gzip support is not built in";
+  return false;
+}
+
+#endif // LOGANALYZER_HAVE_ZLIB
+
+bool GzipIndex::save() const {
+  uint64_t fileSize;
+  int64_t mtime;
+  if (checkpoints_.empty() || !statFile(fileSize, mtime))
+    return false;
+
+  std::ofstream out(indexPath(path_), std::ios::binary | std::ios::trunc);
+  if (!out)
+    return false;
+  out.write(kIndexMagic, sizeof(kIndexMagic));
+  writeValue(out, fileSize);
+  writeValue(out, mtime);
+  writeValue(out, size_);
+  writeValue(out, lineCount_);
+  writeValue(out, static_cast<uint64_t>(checkpoints_.size()));
+  for (const auto &cp : checkpoints_) {
+    writeValue(out, cp.out);
+    writeValue(out, cp.in);
+    writeValue(out, cp.firstLine);
+    writeValue(out, static_cast<int32_t>(cp.bits));
+    writeValue(out, static_cast<uint8_t>(cp.memberStart));
+    writeValue(out, static_cast<uint8_t>(cp.lineStart));
+    writeValue(out, static_cast<uint32_t>(cp.window.size()));
+    out.write(reinterpret_cast<const char *>(cp.window.data()),
+              static_cast<std::streamsize>(cp.window.size()));
+  }
+  return static_cast<bool>(out);
+}
+
+bool GzipIndex::load(const std::string &path) {
+  *this = GzipIndex{};
+  path_ = path;
+
+  uint64_t fileSize;
+  int64_t mtime;
+  std::ifstream in(indexPath(path), std::ios::binary);
+  if (!in || !statFile(fileSize, mtime))
+    return false;
+
+  char magic[sizeof(kIndexMagic)];
+  uint64_t savedSize, count;
+  int64_t savedMtime;
+  if (!in.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kIndexMagic, sizeof(magic)) != 0 ||
+      !readValue(in, savedSize) || !readValue(in, savedMtime) ||
+      savedSize != fileSize || savedMtime != mtime ||
+      !readValue(in, size_) || !readValue(in, lineCount_) ||
+      !readValue(in, count) || count == 0 || count > fileSize + 1) {
+    return false;
+  }
+
+  // A corrupt or foreign index must not send inflateFrom() outside the
+  // file or fillCache() before the first checkpoint: checkpoints start at
+  // line 0 and offset 0 and move forward in both streams, and bits refers
+  // to the byte before in. Strictly increasing input offsets also bound
+  // count by the file size, checked before anything is allocated.
+  std::vector<Checkpoint> checkpoints;
+  for (size_t c = 0; c < count; ++c) {
+    Checkpoint &cp = checkpoints.emplace_back();
+    int32_t bits;
+    uint8_t memberStart, lineStart;
+    uint32_t windowSize;
+    if (!readValue(in, cp.out) || !readValue(in, cp.in) ||
+        !readValue(in, cp.firstLine) || !readValue(in, bits) ||
+        !readValue(in, memberStart) || !readValue(in, lineStart) ||
+        !readValue(in, windowSize) || windowSize > kWindowSize ||
+        cp.in > fileSize || cp.out > size_ || cp.firstLine > lineCount_ ||
+        bits < 0 || bits > 7 || (bits > 0 && cp.in == 0)) {
+      return false;
+    }
+    if (c == 0 ? cp.in != 0 || cp.out != 0 || cp.firstLine != 0 ||
+                     memberStart == 0 || lineStart == 0
+               : cp.in <= checkpoints[c - 1].in ||
+                     cp.out <= checkpoints[c - 1].out ||
+                     cp.firstLine < checkpoints[c - 1].firstLine) {
+      return false;
+    }
+    cp.bits = bits;
+    cp.memberStart = memberStart != 0;
+    cp.lineStart = lineStart != 0;
+    cp.window.resize(windowSize);
+    if (!in.read(reinterpret_cast<char *>(cp.window.data()), windowSize))
+      return false;
+  }
+
+  file_ = std::make_unique<MemoryMappedFile>(path);
+  if (!file_->isOpen())
+    return false;
+  checkpoints_ = std::move(checkpoints);
+  return true;
+}
+
+bool GzipIndex::fillCache(uint64_t first, size_t count) {
+  // Last checkpoint whose first line is at or before the wanted one
+  auto it = std::upper_bound(
+      checkpoints_.begin(), checkpoints_.end(), first,
+      [](uint64_t line, const Checkpoint &cp) { return line < cp.firstLine; });
+  const size_t c = (it - checkpoints_.begin()) - 1;
+  const Checkpoint &cp = checkpoints_[c];
+
+  // Inflate whole lines from the checkpoint's first line on, past the
+  // wanted ones and at least one checkpoint spacing
+  const uint64_t wantedLines = first + count - cp.firstLine;
+  std::string text;
+  uint64_t newlines = 0;
+  bool skipping = !cp.lineStart; // Tail of a line started earlier
+  bool atEnd = true;
+  bool ok = inflateFrom(c, [&](const char *chunk, size_t size) {
+    if (skipping) {
+      const auto *nl =
+          static_cast<const char *>(std::memchr(chunk, '\n', size));
+      if (!nl)
+        return true;
+      size -= nl + 1 - chunk;
+      chunk = nl + 1;
+      skipping = false;
+    }
+    newlines += std::count(chunk, chunk + size, '\n');
+    text.append(chunk, size);
+    if (newlines >= wantedLines && text.size() >= kSpacing) {
+      atEnd = false;
+      return false;
+    }
+    return true;
+  });
+  if (!ok)
+    return false;
+  // Short of the end of the file the last line may be cut off
+  if (!atEnd)
+    text.resize(text.rfind('\n') + 1);
+
+  cacheText_ = std::move(text);
+  cacheFirstLine_ = cp.firstLine;
+  cacheLineStarts_.clear();
+  if (!cacheText_.empty())
+    cacheLineStarts_.push_back(0);
+  for (size_t i = 0; i + 1 < cacheText_.size(); ++i) {
+    if (cacheText_[i] == '\n')
+      cacheLineStarts_.push_back(i + 1);
+  }
+  return true;
+}
+
+bool GzipIndex::readLines(uint64_t first, size_t count,
+                          std::vector<std::string_view> &lines) {
+  lines.clear();
+  if (checkpoints_.empty() || first >= lineCount_)
+    return true;
+  count = static_cast<size_t>(std::min<uint64_t>(count, lineCount_ - first));
+
+  if (first < cacheFirstLine_ ||
+      first + count > cacheFirstLine_ + cacheLineStarts_.size()) {
+    if (!fillCache(first, count))
+      return false;
+  }
+
+  for (uint64_t i = first; i < first + count; ++i) {
+    const size_t idx = static_cast<size_t>(i - cacheFirstLine_);
+    if (idx >= cacheLineStarts_.size())
+      break;
+    size_t start = cacheLineStarts_[idx];
+    size_t end = idx + 1 < cacheLineStarts_.size() ? cacheLineStarts_[idx + 1]
+                                                   : cacheText_.size();
+    if (end > start && cacheText_[end - 1] == '\n')
+      end--;
+    if (end > start && cacheText_[end - 1] == '\r')
+      end--;
+    lines.emplace_back(cacheText_.data() + start, end - start);
+  }
+  return true;
+}
+
+} // namespace loganalyzer
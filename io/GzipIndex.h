@@ -0,0 +1,85 @@
+#pragma once
+
+#include "MemoryMappedFile.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Random access by line into a gzip file, zran style.
+ *
+ * build() inflates the file once and records a checkpoint roughly every
+ * kSpacing bytes of output: the input position at a deflate block boundary
+ * plus the 32 KB window the next block may refer back to. Reading a line
+ * then only inflates from the checkpoint before it. Concatenated members
+ * are supported; checkpoints at a member start need no window.
+ *
+ * The index is saved next to the file (indexPath()) and reused while the
+ * file's size and modification time match and its checkpoints are
+ * consistent; otherwise load() fails and the caller builds it again.
+ * Needs zlib (LOGANALYZER_HAVE_ZLIB); without it build() fails.
+ */
+class GzipIndex {
+public:
+  struct Checkpoint {
+    uint64_t out = 0;       // Uncompressed offset
+    uint64_t in = 0;        // Compressed offset of the first whole byte
+    uint64_t firstLine = 0; // First line starting at or after out
+    int bits = 0;           // Bits of the byte before in still unused
+    bool memberStart = false; // in is a gzip header; no window needed
+    bool lineStart = false;   // A line starts exactly at out
+    std::vector<unsigned char> window; // Output just before out
+  };
+
+  // Uncompressed bytes between checkpoints
+  static constexpr uint64_t kSpacing = 1024 * 1024;
+
+  static std::string indexPath(const std::string &path) {
+    return path + ".gzidx";
+  }
+
+  // Inflates all of path; progress gets the fraction of input read
+  bool build(const std::string &path,
+             const std::function<void(float)> &progress = nullptr);
+  // Loads the saved index of path if it is still up to date
+  bool load(const std::string &path);
+  bool save() const;
+
+  const std::string &error() const { return error_; }
+  uint64_t size() const { return size_; } // Uncompressed bytes
+  uint64_t lineCount() const { return lineCount_; }
+  const std::vector<Checkpoint> &checkpoints() const { return checkpoints_; }
+
+  // Lines [first, first + count) without line terminators. The views stay
+  // valid until the next call. Text from the last checkpoint read is kept,
+  // so nearby lines come without inflating again.
+  bool readLines(uint64_t first, size_t count,
+                 std::vector<std::string_view> &lines);
+
+private:
+  // Inflates from checkpoint c, passing output to sink until it returns
+  // false or the input ends
+  bool inflateFrom(size_t c,
+                   const std::function<bool(const char *, size_t)> &sink);
+  bool fillCache(uint64_t first, size_t count);
+  bool statFile(uint64_t &fileSize, int64_t &mtime) const;
+
+  std::string path_;
+  std::unique_ptr<MemoryMappedFile> file_;
+  std::vector<Checkpoint> checkpoints_;
+  uint64_t size_ = 0;
+  uint64_t lineCount_ = 0;
+  std::string error_;
+
+  // Whole lines inflated by the last read, from line cacheFirstLine_ on
+  std::string cacheText_;
+  std::vector<size_t> cacheLineStarts_;
+  uint64_t cacheFirstLine_ = 0;
+};
+
+} // namespace loganalyzer
@@ -0,0 +1,96 @@
+#include "InputPaths.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <glob.h>
+#include <set>
+#include <sys/stat.h>
+#include <system_error>
+#include <utility>
+
+namespace loganalyzer {
+
+namespace {
+
+void addUnique(std::vector<std::string> &files, std::string path) {
+  if (std::find(files.begin(), files.end(), path) == files.end())
+    files.push_back(std::move(path));
+}
+
+} // namespace
+
+std::vector<std::string>
+InputPaths::unique(const std::vector<std::string> &paths) {
+  std::vector<std::string> result;
+  std::set<std::pair<uint64_t, uint64_t>> seenFiles;
+  std::set<std::string> seenNames;
+  for (const auto &path : paths) {
+    struct stat sb;
+    const bool isNew =
+        ::stat(path.c_str(), &sb) == 0
+            ? seenFiles
+                  .emplace(static_cast<uint64_t>(sb.st_dev),
+                           static_cast<uint64_t>(sb.st_ino))
+                  .second
+            : seenNames.insert(path).second;
+    if (isNew)
+      result.push_back(path);
+  }
+  return result;
+}
+
+bool InputPaths::isGlob(const std::string &input) {
+  return input.find_first_of("*?[") != std::string::npos;
+}
+
+bool InputPaths::expand(const std::vector<std::string> &inputs,
+                        std::vector<std::string> &files, std::string &error) {
+  files.clear();
+  for (const auto &input : inputs) {
+    if (input == "-") {
+      addUnique(files, input);
+      continue;
+    }
+
+    std::error_code ec;
+    if (std::filesystem::is_directory(input, ec)) {
+      std::vector<std::string> entries;
+      for (const auto &entry :
+           std::filesystem::directory_iterator(input, ec)) {
+        if (entry.is_regular_file(ec))
+          entries.push_back(entry.path().string());
+      }
+      if (entries.empty()) {
+        error = "No files in directory: " + input;
+        return false;
+      }
+      std::sort(entries.begin(), entries.end());
+      for (auto &entry : entries)
+        addUnique(files, std::move(entry));
+      continue;
+    }
+
+    if (!isGlob(input)) {
+      addUnique(files, input);
+      continue;
+    }
+
+    glob_t matches{};
+    int rc = ::glob(input.c_str(), 0, nullptr, &matches);
+    if (rc == 0) {
+      for (size_t i = 0; i < matches.gl_pathc; ++i) {
+        if (std::filesystem::is_regular_file(matches.gl_pathv[i], ec))
+          addUnique(files, matches.gl_pathv[i]);
+      }
+    }
+    globfree(&matches);
+    if (rc != 0) {
+      error = "No files match: " + input;
+      return false;
+    }
+  }
+  files = unique(files);
+  return true;
+}
+
+} // namespace loganalyzer
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Turns user-supplied inputs into the list of files to analyze.
+ *
+ * Each input is a file path, a directory (its regular files, sorted by
+ * name, not recursive) or a glob pattern with *, ? or [...] (matches in
+ * glob order). "-" is kept as is for stdin. Duplicates are dropped, the
+ * first occurrence keeps its place and spelling (see unique()).
+ */
+class InputPaths {
+public:
+  // False with error set if an input matches nothing
+  static bool expand(const std::vector<std::string> &inputs,
+                     std::vector<std::string> &files, std::string &error);
+
+  static bool isGlob(const std::string &input);
+
+  // paths without those naming a file already listed: same device and
+  // inode, so "a", "./a", an absolute path or a symlink count once. Paths
+  // that cannot be stat'ed (missing files, "-") are compared as strings.
+  static std::vector<std::string>
+  unique(const std::vector<std::string> &paths);
+};
+
+} // namespace loganalyzer
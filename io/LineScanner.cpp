@@ -0,0 +1,190 @@
+#include "LineScanner.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LOGANALYZER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace loganalyzer {
+
+namespace {
+
+constexpr size_t kBlockSize = 64;
+
+// Fills masks[i] with one bit per byte of block i that equals '\n'
+using MaskKernel = void (*)(const char *p, size_t blocks, uint64_t *masks);
+
+// SWAR: high bit of each byte that is '\n' (exact, no false positives)
+inline uint64_t newlineBytes(uint64_t word) {
+  constexpr uint64_t kNewlines = 0x0A0A0A0A0A0A0A0AULL;
+  constexpr uint64_t kLow7 = 0x7F7F7F7F7F7F7F7FULL;
+  uint64_t x = word ^ kNewlines;
+  return ~(((x & kLow7) + kLow7) | x) & ~kLow7;
+}
+
+void scalarMasks(const char *p, size_t blocks, uint64_t *masks) {
+  for (size_t b = 0; b < blocks; ++b, p += kBlockSize) {
+    uint64_t mask = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+      for (size_t w = 0; w < kBlockSize / 8; ++w) {
+        uint64_t word;
+        std::memcpy(&word, p + w * 8, 8);
+        // Gather the 8 flag bits (one per byte) into the low byte
+        uint64_t bits =
+            ((newlineBytes(word) >> 7) * 0x0102040810204080ULL) >> 56;
+        mask |= bits << (w * 8);
+      }
+    } else {
+      for (size_t i = 0; i < kBlockSize; ++i) {
+        mask |= static_cast<uint64_t>(p[i] == '\n') << i;
+      }
+    }
+    masks[b] = mask;
+  }
+}
+
+#ifdef LOGANALYZER_X86
+__attribute__((target("sse2"))) void sse2Masks(const char *p, size_t blocks,
+                                               uint64_t *masks) {
+  const __m128i nl = _mm_set1_epi8('\n');
+  for (size_t b = 0; b < blocks; ++b, p += kBlockSize) {
+    auto lane = [&](int i) -> uint64_t {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p) + i);
+      return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)));
+    };
+    masks[b] = lane(0) | (lane(1) << 16) | (lane(2) << 32) | (lane(3) << 48);
+  }
+}
+
+__attribute__((target("avx2"))) void avx2Masks(const char *p, size_t blocks,
+                                               uint64_t *masks) {
+  const __m256i nl = _mm256_set1_epi8('\n');
+  for (size_t b = 0; b < blocks; ++b, p += kBlockSize) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p) + 1);
+    uint64_t mLo = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, nl)));
+    uint64_t mHi = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, nl)));
+    masks[b] = mLo | (mHi << 32);
+  }
+}
+#endif
+
+MaskKernel kernelFunction(ScanKernel kernel) {
+  switch (kernel) {
+#ifdef LOGANALYZER_X86
+  case ScanKernel::AVX2:
+    return avx2Masks;
+  case ScanKernel::SSE2:
+    return sse2Masks;
+#endif
+  default:
+    return scalarMasks;
+  }
+}
+
+} // namespace
+
+LineScanner::LineScanner(std::string_view data, ScanKernel kernel)
+    : data_(data), kernel_(isSupported(kernel) ? kernel : ScanKernel::Scalar) {
+}
+
+void LineScanner::refill() {
+  MaskKernel fn = kernelFunction(kernel_);
+  size_t remaining = data_.size() - maskBase_;
+  size_t fullBlocks = std::min(remaining / kBlockSize, kBlocksPerRefill);
+
+  if (fullBlocks > 0) {
+    fn(data_.data() + maskBase_, fullBlocks, masks_);
+    maskCount_ = fullBlocks;
+  } else {
+    // Tail shorter than one block: scan a zero-padded copy
+    char tail[kBlockSize] = {};
+    std::memcpy(tail, data_.data() + maskBase_, remaining);
+    fn(tail, 1, masks_);
+    maskCount_ = 1;
+  }
+  maskIndex_ = 0;
+}
+
+size_t LineScanner::nextBatch(LineSpan *out, size_t maxSpans) {
+  size_t count = 0;
+
+  while (count < maxSpans && !done_) {
+    if (maskIndex_ == maskCount_) {
+      size_t scanned = maskBase_ + maskCount_ * kBlockSize;
+      if (scanned >= data_.size()) {
+        // No newline left: hand out the unterminated last line, if any
+        if (lineStart_ < data_.size()) {
+          out[count++] = {lineStart_, data_.size()};
+          lineStart_ = data_.size();
+        }
+        done_ = true;
+        break;
+      }
+      maskBase_ = scanned;
+      refill();
+      continue;
+    }
+
+    uint64_t &mask = masks_[maskIndex_];
+    if (mask == 0) {
+      ++maskIndex_;
+      continue;
+    }
+
+    size_t newlinePos =
+        maskBase_ + maskIndex_ * kBlockSize + std::countr_zero(mask);
+    mask &= mask - 1; // Clear lowest set bit
+    out[count++] = {lineStart_, newlinePos};
+    lineStart_ = newlinePos + 1;
+  }
+
+  return count;
+}
+
+ScanKernel LineScanner::bestKernel() {
+  static const ScanKernel best = [] {
+    if (isSupported(ScanKernel::AVX2))
+      return ScanKernel::AVX2;
+    if (isSupported(ScanKernel::SSE2))
+      return ScanKernel::SSE2;
+    return ScanKernel::Scalar;
+  }();
+  return best;
+}
+
+bool LineScanner::isSupported(ScanKernel kernel) {
+  switch (kernel) {
+  case ScanKernel::Scalar:
+    return true;
+#ifdef LOGANALYZER_X86
+  case ScanKernel::SSE2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+  case ScanKernel::AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+const char *LineScanner::kernelName(ScanKernel kernel) {
+  switch (kernel) {
+  case ScanKernel::Scalar:
+    return "scalar";
+  case ScanKernel::SSE2:
+    return "sse2";
+  case ScanKernel::AVX2:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+} // namespace loganalyzer
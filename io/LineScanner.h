@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace loganalyzer {
+
+// A line located by LineScanner: [begin, end) byte offsets relative to the
+// scanned buffer. The terminating '\n' is not included; a trailing '\r' is
+// left for the caller to strip.
+struct LineSpan {
+  size_t begin;
+  size_t end;
+};
+
+// Newline bitmask kernels. The best supported one is picked at runtime.
+enum class ScanKernel { Scalar, SSE2, AVX2 };
+
+/**
+ * @brief Vectorized line splitter.
+ *
+ * Builds 64-bit newline masks for 64-byte blocks with the selected SIMD
+ * kernel and walks the set bits, handing out line spans in batches instead of
+ * calling find('\n') once per line.
+ *
+ * A final line without a terminating newline is returned as well; an empty
+ * remainder after the last '\n' is not.
+ */
+class LineScanner {
+public:
+  explicit LineScanner(std::string_view data,
+                       ScanKernel kernel = bestKernel());
+
+  // Write up to maxSpans spans into out. Returns the number written; 0 means
+  // the buffer is exhausted.
+  size_t nextBatch(LineSpan *out, size_t maxSpans);
+
+  // Offset of the first byte not yet handed out
+  size_t position() const { return lineStart_; }
+
+  ScanKernel kernel() const { return kernel_; }
+
+  static ScanKernel bestKernel();
+  static bool isSupported(ScanKernel kernel);
+  static const char *kernelName(ScanKernel kernel);
+
+private:
+  void refill();
+
+  std::string_view data_;
+  ScanKernel kernel_;
+
+  size_t lineStart_ = 0; // Start of the next line to hand out
+  size_t maskBase_ = 0;  // Offset of masks_[0]
+  size_t maskCount_ = 0; // Valid entries in masks_
+  size_t maskIndex_ = 0; // Current entry in masks_
+  bool done_ = false;
+
+  static constexpr size_t kBlocksPerRefill = 64; // 4 KB of input per refill
+  uint64_t masks_[kBlocksPerRefill];
+};
+
+} // namespace loganalyzer
@@ -4,12 +4,38 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <algorithm>
 
 namespace loganalyzer {
 
-MemoryMappedFile::MemoryMappedFile(const std::string &filepath) 
-    : fd_(-1), size_(0), data_(MAP_FAILED) {
-    
+namespace {
+
+size_t pageSize() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+int adviceFor(MemoryMappedFile::Access access) {
+    switch (access) {
+    case MemoryMappedFile::Access::Sequential:
+        return MADV_SEQUENTIAL;
+    case MemoryMappedFile::Access::Random:
+        return MADV_RANDOM;
+    case MemoryMappedFile::Access::Normal:
+        break;
+    }
+    return MADV_NORMAL;
+}
+
+} // namespace
+
+MemoryMappedFile::MemoryMappedFile(const std::string &filepath)
+    : MemoryMappedFile(filepath, Options{}) {}
+
+MemoryMappedFile::MemoryMappedFile(const std::string &filepath,
+                                   const Options &options)
+    : fd_(-1), size_(0), data_(MAP_FAILED), options_(options) {
+
     fd_ = open(filepath.c_str(), O_RDONLY);
     if (fd_ == -1) {
         return;
@@ -46,13 +72,33 @@ MemoryMappedFile::MemoryMappedFile(const std::string &filepath)
              data_ = nullptr; // Distinct from MAP_FAILED
              return;
         }
+    } else if (options.windowed) {
+        // Mapped piecewise by map(); the file stays open for it
+        data_ = nullptr;
     } else {
-        data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        if (options.populate) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        data_ = mmap(nullptr, size_, PROT_READ, flags, fd_, 0);
         if (data_ == MAP_FAILED) {
             close(fd_);
             fd_ = -1;
             size_ = 0;
+            return;
+        }
+
+        // Hints only: failures are harmless
+        if (options.access != Access::Normal) {
+            madvise(data_, size_, adviceFor(options.access));
+        }
+#ifdef MADV_HUGEPAGE
+        if (options.hugePages) {
+            madvise(data_, size_, MADV_HUGEPAGE);
         }
+#endif
     }
 }
 
@@ -66,7 +112,8 @@ MemoryMappedFile::~MemoryMappedFile() {
 }
 
 MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept 
-    : fd_(other.fd_), size_(other.size_), data_(other.data_) {
+    : fd_(other.fd_), size_(other.size_), data_(other.data_),
+      options_(other.options_) {
     other.fd_ = -1;
     other.size_ = 0;
     other.data_ = MAP_FAILED;
@@ -84,6 +131,7 @@ MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
         fd_ = other.fd_;
         size_ = other.size_;
         data_ = other.data_;
+        options_ = other.options_;
         
         other.fd_ = -1;
         other.size_ = 0;
@@ -109,4 +157,77 @@ std::string_view MemoryMappedFile::getView() const {
     return std::string_view(static_cast<const char*>(data_), size_);
 }
 
+void MemoryMappedFile::willNeed(size_t offset, size_t length) const {
+    if (data_ == MAP_FAILED || data_ == nullptr || offset >= size_) return;
+    size_t end = std::min(size_, offset + length);
+    size_t begin = offset / pageSize() * pageSize();
+    madvise(static_cast<char*>(data_) + begin, end - begin, MADV_WILLNEED);
+}
+
+void MemoryMappedFile::dontNeed(size_t offset, size_t length) const {
+    if (data_ == MAP_FAILED || data_ == nullptr || offset >= size_) return;
+    size_t begin = (offset + pageSize() - 1) / pageSize() * pageSize();
+    size_t end = std::min(size_, offset + length);
+    // The last page may be partial only at the end of the file
+    if (end < size_) end = end / pageSize() * pageSize();
+    if (begin >= end) return;
+    madvise(static_cast<char*>(data_) + begin, end - begin, MADV_DONTNEED);
+}
+
+MemoryMappedFile::Window MemoryMappedFile::map(size_t offset,
+                                               size_t length) const {
+    Window window;
+    if (fd_ == -1 || offset >= size_) return window;
+    length = std::min(length, size_ - offset);
+    size_t begin = offset / pageSize() * pageSize();
+
+    void *base = mmap(nullptr, length + (offset - begin), PROT_READ,
+                      MAP_PRIVATE, fd_, static_cast<off_t>(begin));
+    if (base == MAP_FAILED) return window;
+    if (options_.access != Access::Normal) {
+        madvise(base, length + (offset - begin), adviceFor(options_.access));
+    }
+
+    window.base_ = base;
+    window.length_ = length + (offset - begin);
+    window.view_ = std::string_view(
+        static_cast<const char*>(base) + (offset - begin), length);
+    return window;
+}
+
+void MemoryMappedFile::evict(size_t offset, size_t length) const {
+    if (fd_ == -1 || offset >= size_) return;
+    size_t begin = (offset + pageSize() - 1) / pageSize() * pageSize();
+    size_t end = std::min(size_, offset + length);
+    if (end < size_) end = end / pageSize() * pageSize();
+    if (begin >= end) return;
+    posix_fadvise(fd_, static_cast<off_t>(begin),
+                  static_cast<off_t>(end - begin), POSIX_FADV_DONTNEED);
+}
+
+MemoryMappedFile::Window::~Window() {
+    if (base_) munmap(base_, length_);
+}
+
+MemoryMappedFile::Window::Window(Window&& other) noexcept
+    : base_(other.base_), length_(other.length_), view_(other.view_) {
+    other.base_ = nullptr;
+    other.length_ = 0;
+    other.view_ = {};
+}
+
+MemoryMappedFile::Window& MemoryMappedFile::Window::operator=(
+    Window&& other) noexcept {
+    if (this != &other) {
+        if (base_) munmap(base_, length_);
+        base_ = other.base_;
+        length_ = other.length_;
+        view_ = other.view_;
+        other.base_ = nullptr;
+        other.length_ = 0;
+        other.view_ = {};
+    }
+    return *this;
+}
+
 } // namespace loganalyzer
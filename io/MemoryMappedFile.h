@@ -8,7 +8,39 @@ namespace loganalyzer {
 
 class MemoryMappedFile {
 public:
+  // How the mapping will be read, passed on with madvise()
+  enum class Access { Normal, Sequential, Random };
+
+  struct Options {
+    Access access = Access::Normal;
+    bool populate = false;  // MAP_POPULATE: fault in the whole file now
+    bool hugePages = false; // MADV_HUGEPAGE; needs kernel support for
+                            // huge pages in the page cache, else ignored
+    bool windowed = false;  // Keep the file open for map() instead of
+                            // mapping all of it; getView() is empty
+  };
+
+  // Read-only mapping of part of the file, unmapped when destroyed
+  class Window {
+  public:
+    Window() = default;
+    ~Window();
+    Window(Window &&other) noexcept;
+    Window &operator=(Window &&other) noexcept;
+    Window(const Window &) = delete;
+    Window &operator=(const Window &) = delete;
+
+    std::string_view view() const { return view_; }
+
+  private:
+    friend class MemoryMappedFile;
+    void *base_ = nullptr; // Page-aligned start of the mapping
+    size_t length_ = 0;
+    std::string_view view_;
+  };
+
   explicit MemoryMappedFile(const std::string &filepath);
+  MemoryMappedFile(const std::string &filepath, const Options &options);
   ~MemoryMappedFile();
 
   // Disable copy
@@ -24,10 +56,25 @@ public:
   size_t size() const;
   std::string_view getView() const;
 
+  // Hints for [offset, offset + length): start reading it in the
+  // background, or drop it from this process (it is faulted in again from
+  // the page cache if touched). dontNeed() only drops whole pages inside
+  // the range, so neighbouring ranges are not affected.
+  void willNeed(size_t offset, size_t length) const;
+  void dontNeed(size_t offset, size_t length) const;
+
+  // Maps [offset, offset + length), clamped to the file; an empty view on
+  // failure. Works whether or not the whole file is mapped.
+  Window map(size_t offset, size_t length) const;
+  // Drops the whole pages inside the range from the page cache, so a scan
+  // of a huge file does not push out everyone else's data
+  void evict(size_t offset, size_t length) const;
+
 private:
   int fd_;
   size_t size_;
   void* data_;
+  Options options_;
 };
 
 } // namespace loganalyzer
@@ -0,0 +1,336 @@
+#include "StreamReader.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace loganalyzer {
+
+namespace {
+
+// How long the reader blocks in poll() before rechecking for stop()
+constexpr int kPollTimeoutMs = 100;
+
+// Compressed input read ahead of the decompressor. Several BGZF members
+// fit, so a batch can be inflated in parallel.
+constexpr size_t kRawBufferSize = 2 * 1024 * 1024;
+
+// pread() calls end on multiples of this where they can, so the following
+// call starts on a page boundary
+constexpr size_t kReadAlignment = 64 * 1024;
+
+} // namespace
+
+StreamReader::StreamReader(const std::string &path, size_t blockSize,
+                           size_t blockCount, unsigned decodeThreads)
+    : blockSize_(std::max<size_t>(blockSize, 1)),
+      decodeThreads_(decodeThreads) {
+  if (path == "-") {
+    fd_ = STDIN_FILENO;
+  } else {
+    // Opening a FIFO blocks until a writer shows up, like cat does
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    ownsFd_ = true;
+  }
+  if (fd_ == -1)
+    return;
+
+  struct stat sb;
+  if (ownsFd_ && ::fstat(fd_, &sb) == 0 && S_ISREG(sb.st_mode)) {
+    regularFile_ = true;
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+
+  // Buffers are allocated by the reader on first use
+  for (size_t i = 0; i < std::max<size_t>(blockCount, 1); ++i) {
+    blocks_.push_back(std::make_unique<Block>());
+    free_.push_back(blocks_.back().get());
+  }
+  reader_ = std::thread(&StreamReader::readerLoop, this);
+}
+
+StreamReader::~StreamReader() {
+  stop();
+  if (reader_.joinable()) {
+    reader_.join();
+  }
+  if (ownsFd_ && fd_ != -1) {
+    ::close(fd_);
+  }
+}
+
+bool StreamReader::failed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return failed_;
+}
+
+std::string StreamReader::error() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return error_;
+}
+
+StreamReader::Block *StreamReader::next() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock,
+                [&] { return stopping_ || finished_ || !full_.empty(); });
+  if (stopping_ || full_.empty())
+    return nullptr;
+  Block *block = full_.front();
+  full_.pop_front();
+  return block;
+}
+
+void StreamReader::release(Block *block) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(block);
+  }
+  changed_.notify_all();
+}
+
+void StreamReader::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+}
+
+bool StreamReader::isStreamPath(const std::string &path) {
+  if (path == "-")
+    return true;
+  struct stat sb;
+  if (::stat(path.c_str(), &sb) == -1)
+    return false; // Left to the regular open to report
+  return !S_ISREG(sb.st_mode);
+}
+
+bool StreamReader::needsStreaming(const std::string &path) {
+  return isStreamPath(path) ||
+         Decompressor::detectFile(path) != Compression::None;
+}
+
+bool StreamReader::waitReadable() {
+  pollfd pfd{fd_, POLLIN, 0};
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stopping_)
+        return false;
+    }
+    int ready = ::poll(&pfd, 1, kPollTimeoutMs);
+    if (ready != 0)
+      return true; // Readable, hung up, or an error read() will report
+  }
+}
+
+ssize_t StreamReader::readRaw(char *dst, size_t size) {
+  if (regularFile_)
+    return readFile(dst, size);
+  while (waitReadable()) {
+    ssize_t n = ::read(fd_, dst, size);
+    if (n >= 0 || errno != EINTR)
+      return n;
+  }
+  return 0;
+}
+
+ssize_t StreamReader::readFile(char *dst, size_t size) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_)
+      return 0;
+  }
+  // End on an aligned offset unless that leaves nothing to read
+  const uint64_t alignedEnd = (fileOffset_ + size) / kReadAlignment *
+                              kReadAlignment;
+  if (alignedEnd > fileOffset_)
+    size = static_cast<size_t>(alignedEnd - fileOffset_);
+
+  while (true) {
+    ssize_t n = ::pread(fd_, dst, size, static_cast<off_t>(fileOffset_));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n > 0) {
+      fileOffset_ += static_cast<uint64_t>(n);
+      // Start reading the next range while this one is parsed
+      ::posix_fadvise(fd_, static_cast<off_t>(fileOffset_),
+                      static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+    }
+    return n;
+  }
+}
+
+ssize_t StreamReader::readInput(char *dst, size_t size) {
+  if (!detected_) {
+    // Buffer the first bytes to look for a magic number
+    detected_ = true;
+    raw_.resize(kRawBufferSize);
+    while (rawEnd_ < 4 && !rawEof_) {
+      ssize_t n = readRaw(raw_.data() + rawEnd_, raw_.size() - rawEnd_);
+      if (n < 0) {
+        error_ = std::strerror(errno);
+        return n;
+      }
+      rawEnd_ += static_cast<size_t>(n);
+      rawEof_ = n == 0;
+    }
+
+    compression_ = Decompressor::detect({raw_.data(), rawEnd_});
+    if (compression_ != Compression::None) {
+      decompressor_ = Decompressor::create(compression_, decodeThreads_);
+      if (!decompressor_) {
+        error_ = std::string(Decompressor::name(compression_)) +
+                 " input is not supported by this build";
+        return -1;
+      }
+    }
+  }
+
+  if (!decompressor_) {
+    if (rawBegin_ < rawEnd_) {
+      size_t n = std::min(size, rawEnd_ - rawBegin_);
+      std::memcpy(dst, raw_.data() + rawBegin_, n);
+      rawBegin_ += n;
+      if (rawBegin_ == rawEnd_) {
+        raw_.clear();
+        raw_.shrink_to_fit();
+      }
+      return static_cast<ssize_t>(n);
+    }
+    if (rawEof_)
+      return 0;
+    ssize_t n = readRaw(dst, size);
+    if (n < 0)
+      error_ = std::strerror(errno);
+    return n;
+  }
+
+  while (true) {
+    std::string_view input(raw_.data() + rawBegin_, rawEnd_ - rawBegin_);
+    size_t n = decompressor_->decompress(input, dst, size);
+    rawBegin_ = rawEnd_ - input.size();
+    if (decompressor_->failed()) {
+      error_ = decompressor_->error();
+      return -1;
+    }
+    if (n > 0)
+      return static_cast<ssize_t>(n);
+    if (rawEof_) {
+      if (rawBegin_ == rawEnd_ && decompressor_->finished())
+        return 0;
+      error_ = std::string("Truncated ") + Decompressor::name(compression_) +
+               " input";
+      return -1;
+    }
+
+    // The decompressor needs more input: top up the buffer
+    std::memmove(raw_.data(), raw_.data() + rawBegin_, rawEnd_ - rawBegin_);
+    rawEnd_ -= rawBegin_;
+    rawBegin_ = 0;
+    if (rawEnd_ == raw_.size())
+      raw_.resize(raw_.size() * 2);
+    while (rawEnd_ < raw_.size()) {
+      ssize_t got = readRaw(raw_.data() + rawEnd_, raw_.size() - rawEnd_);
+      if (got < 0) {
+        error_ = std::strerror(errno);
+        return -1;
+      }
+      if (got == 0) {
+        rawEof_ = true;
+        break;
+      }
+      rawEnd_ += static_cast<size_t>(got);
+    }
+  }
+}
+
+void StreamReader::readerLoop() {
+  std::string carry; // Partial last line of the previous block
+  uint64_t offset = 0;
+  uint64_t index = 0;
+  bool eof = false;
+
+  while (!eof) {
+    Block *block;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      changed_.wait(lock, [&] { return stopping_ || !free_.empty(); });
+      if (stopping_)
+        break;
+      block = free_.front();
+      free_.pop_front();
+    }
+
+    // Give back memory from an earlier oversized line
+    std::vector<char> &buffer = block->buffer;
+    if (buffer.size() != blockSize_) {
+      buffer.resize(blockSize_);
+      buffer.shrink_to_fit();
+    }
+    if (carry.size() >= buffer.size())
+      buffer.resize(carry.size() * 2);
+
+    std::memcpy(buffer.data(), carry.data(), carry.size());
+    size_t filled = carry.size();
+    size_t lineEnd = 0; // End of the last complete line
+
+    while (true) {
+      while (filled < buffer.size()) {
+        ssize_t n = readInput(buffer.data() + filled, buffer.size() - filled);
+        if (n < 0) {
+          // An error while stopping is just the cut-off input
+          std::lock_guard<std::mutex> lock(mutex_);
+          failed_ = !stopping_;
+          eof = true;
+          break;
+        }
+        if (n == 0) {
+          eof = true;
+          break;
+        }
+        filled += static_cast<size_t>(n);
+      }
+
+      if (eof) {
+        lineEnd = filled; // Unterminated last line included
+        break;
+      }
+      size_t lastNewline = std::string_view(buffer.data(), filled).rfind('\n');
+      if (lastNewline != std::string_view::npos) {
+        lineEnd = lastNewline + 1;
+        break;
+      }
+      // One line fills the whole block: grow it
+      buffer.resize(buffer.size() * 2);
+    }
+
+    carry.assign(buffer.data() + lineEnd, filled - lineEnd);
+    block->size = lineEnd;
+    block->offset = offset;
+    block->index = index;
+    offset += lineEnd;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (lineEnd > 0) {
+        full_.push_back(block);
+        ++index;
+      } else {
+        free_.push_back(block);
+      }
+    }
+    changed_.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished_ = true;
+  }
+  changed_.notify_all();
+}
+
+} // namespace loganalyzer
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Decompressor.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+namespace loganalyzer {
+
+/**
+ * @brief Reads stdin or a pipe into a bounded ring of line-aligned blocks.
+ *
+ * A reader thread fills free blocks and queues them in input order; any
+ * number of consumers take full blocks with next() and hand them back with
+ * release(). Every block except the last ends with '\n', so consumers never
+ * see a partial line. Memory stays at blockCount blocks, except that a
+ * single line longer than a block grows that block until it fits.
+ *
+ * gzip and zstd input is recognized by its magic bytes and decompressed on
+ * the reader thread (see Decompressor), so blocks always hold plain text.
+ *
+ * Regular files are read with pread() at aligned offsets, and the kernel is
+ * asked to fetch the next range while the blocks already read are parsed.
+ * Unlike a mapping, a file truncated meanwhile just ends early instead of
+ * raising SIGBUS.
+ */
+class StreamReader {
+public:
+  struct Block {
+    std::vector<char> buffer;
+    size_t size = 0;     // Bytes of complete lines in buffer
+    uint64_t offset = 0; // Offset of the first byte in the stream
+    uint64_t index = 0;  // Position in the stream, 0-based
+
+    std::string_view view() const { return {buffer.data(), size}; }
+  };
+
+  // "-" reads standard input (left open afterwards). decodeThreads is
+  // passed on to the Decompressor for compressed input.
+  explicit StreamReader(const std::string &path, size_t blockSize,
+                        size_t blockCount, unsigned decodeThreads = 1);
+  ~StreamReader();
+
+  StreamReader(const StreamReader &) = delete;
+  StreamReader &operator=(const StreamReader &) = delete;
+
+  bool isOpen() const { return fd_ != -1; }
+
+  // True if reading stopped on an I/O error instead of end of input
+  bool failed() const;
+  // Why reading failed
+  std::string error() const;
+
+  // Next full block, waiting for the reader; nullptr at end of input or
+  // after stop()
+  Block *next();
+  void release(Block *block);
+
+  // Stop reading and wake everyone waiting; unread input is dropped
+  void stop();
+
+  // "-", FIFOs, sockets and character devices: anything that cannot be
+  // memory mapped
+  static bool isStreamPath(const std::string &path);
+  // Streams and compressed files: anything that has to be read through a
+  // StreamReader rather than mapped
+  static bool needsStreaming(const std::string &path);
+
+private:
+  void readerLoop();
+  // Waits for input or stop(); false once stopping
+  bool waitReadable();
+  // read() that gives up on stop(): 0 at end of input or when stopping,
+  // -1 on error
+  ssize_t readRaw(char *dst, size_t size);
+  // readRaw() for regular files
+  ssize_t readFile(char *dst, size_t size);
+  // Fills dst with up to size bytes of (decompressed) input; same results
+  // as readRaw(), with error_ set on -1
+  ssize_t readInput(char *dst, size_t size);
+
+  int fd_ = -1;
+  bool ownsFd_ = false;
+  bool regularFile_ = false; // Opened by path and read with pread()
+  uint64_t fileOffset_ = 0;  // Reader thread only: next pread() offset
+  size_t blockSize_;
+  unsigned decodeThreads_;
+
+  // Reader thread only: compressed input not yet decompressed
+  Compression compression_ = Compression::None;
+  std::unique_ptr<Decompressor> decompressor_;
+  std::vector<char> raw_;
+  size_t rawBegin_ = 0;
+  size_t rawEnd_ = 0;
+  bool rawEof_ = false;
+  bool detected_ = false; // First bytes checked for a compression format
+
+  std::vector<std::unique_ptr<Block>> blocks_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<Block *> free_;
+  std::deque<Block *> full_;
+  bool finished_ = false; // No more blocks will be queued
+  bool stopping_ = false;
+  bool failed_ = false;
+  std::string error_; // Written by the reader before it sets failed_
+
+  std::thread reader_;
+};
+
+} // namespace loganalyzer
@@ -4,26 +4,37 @@
 #include "core/Timestamp.h"
 #include "io/FileWriter.h"
 #include "report/TextReportRenderer.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 using namespace loganalyzer;
 
 struct CliArgs {
-  std::string inputPath;
+  std::vector<std::string> inputPaths; // --input may be repeated
   std::string reportPath;
   std::optional<Timestamp> from;
   std::optional<Timestamp> to;
   std::optional<std::string> keyword;
+  bool printStats = false;
+  size_t topErrorCount = 10;
+  size_t topErrorCapacity = 0; // Counters per thread; 0 counts exactly
+  IoBackend io = IoBackend::Mmap;
+  bool mapPopulate = false;
+  bool mapHugePages = false;
+  uint64_t mapBudget = 0; // Bytes
 };
 
 bool parseArgs(int argc, char *argv[], CliArgs &args) {
   for (int i = 1; i < argc; i++) {
     if (std::strcmp(argv[i], "--input") == 0) {
       if (i + 1 < argc) {
-        args.inputPath = argv[++i];
+        args.inputPaths.push_back(argv[++i]);
       } else {
         return false;
       }
@@ -63,10 +74,77 @@ bool parseArgs(int argc, char *argv[], CliArgs &args) {
       } else {
         return false;
       }
+    } else if (std::strcmp(argv[i], "--top-errors") == 0) {
+      if (i + 1 < argc) {
+        char *end = nullptr;
+        unsigned long long count = std::strtoull(argv[++i], &end, 10);
+        if (*end != '\0' || count == 0) {
+          std::cerr << "Invalid --top-errors, expected a positive count\n";
+          return false;
+        }
+        args.topErrorCount = static_cast<size_t>(count);
+      } else {
+        return false;
+      }
+    } else if (std::strcmp(argv[i], "--top-errors-bounded") == 0) {
+      if (i + 1 < argc) {
+        char *end = nullptr;
+        unsigned long long counters = std::strtoull(argv[++i], &end, 10);
+        if (*end != '\0' || counters == 0) {
+          std::cerr << "Invalid --top-errors-bounded, expected a positive "
+                       "number of counters\n";
+          return false;
+        }
+        args.topErrorCapacity = static_cast<size_t>(counters);
+      } else {
+        return false;
+      }
+    } else if (std::strcmp(argv[i], "--stats") == 0) {
+      args.printStats = true;
+    } else if (std::strcmp(argv[i], "--io") == 0) {
+      if (i + 1 < argc) {
+        std::string backend = argv[++i];
+        if (backend == "mmap") {
+          args.io = IoBackend::Mmap;
+        } else if (backend == "pread") {
+          args.io = IoBackend::Pread;
+        } else {
+          std::cerr << "Invalid --io backend, expected mmap or pread\n";
+          return false;
+        }
+      } else {
+        return false;
+      }
+    } else if (std::strcmp(argv[i], "--map-populate") == 0) {
+      args.mapPopulate = true;
+    } else if (std::strcmp(argv[i], "--map-huge-pages") == 0) {
+      args.mapHugePages = true;
+    } else if (std::strcmp(argv[i], "--map-budget") == 0) {
+      if (i + 1 < argc) {
+        char *end = nullptr;
+        unsigned long long mb = std::strtoull(argv[++i], &end, 10);
+        if (*end != '\0' || mb == 0) {
+          std::cerr << "Invalid --map-budget, expected megabytes\n";
+          return false;
+        }
+        args.mapBudget = static_cast<uint64_t>(mb) * 1024 * 1024;
+      } else {
+        return false;
+      }
     }
   }
 
-  return !args.inputPath.empty() && !args.reportPath.empty();
+  return !args.inputPaths.empty() && !args.reportPath.empty();
+}
+
+std::string joinInputs(const std::vector<std::string> &inputs) {
+  std::string joined;
+  for (const auto &input : inputs) {
+    if (!joined.empty())
+      joined += ", ";
+    joined += input;
+  }
+  return joined;
 }
 
 std::string getCurrentTimestamp() {
@@ -102,22 +180,54 @@ std::string buildFiltersDescription(const CliArgs &args) {
   return oss.str();
 }
 
+// Per-thread busy time, to check that morsels are spread evenly
+void printWorkerStats(const AnalysisResult &result) {
+  std::cout << "Worker statistics:\n";
+  for (const auto &w : result.workerStats) {
+    std::printf("  worker %2u: %8.3f s busy, %5llu morsels, %9.1f MB\n",
+                w.worker, w.busySeconds,
+                static_cast<unsigned long long>(w.morsels),
+                static_cast<double>(w.bytes) / (1024.0 * 1024.0));
+  }
+
+  // Each worker has its own cache, so the hit count varies between runs
+  const uint64_t lookups =
+      result.timestampCacheHits + result.timestampCacheMisses;
+  if (lookups > 0) {
+    std::printf("Timestamp cache hits: %llu / %llu (%.1f%%)\n",
+                static_cast<unsigned long long>(result.timestampCacheHits),
+                static_cast<unsigned long long>(lookups),
+                100.0 * static_cast<double>(result.timestampCacheHits) /
+                    static_cast<double>(lookups));
+  }
+}
+
 int main(int argc, char *argv[]) {
   // Parse CLI arguments
   CliArgs cliArgs;
   if (!parseArgs(argc, argv, cliArgs)) {
-    std::cerr << "Usage: " << argv[0] << " --input <path> --report <path> "
+    std::cerr << "Usage: " << argv[0]
+              << " --input <path|dir|glob|-> [--input ...] --report <path> "
               << "[--from <YYYY-MM-DD HH:MM:SS>] [--to <YYYY-MM-DD HH:MM:SS>] "
-              << "[--keyword <text>]\n";
+              << "[--keyword <text>] [--top-errors <K>] "
+              << "[--top-errors-bounded <counters>] [--stats] "
+              << "[--io mmap|pread] [--map-populate] [--map-huge-pages] "
+              << "[--map-budget <MB>]\n";
     return 2; // INVALID_ARGS
   }
 
   // Build AppRequest
   AppRequest request;
-  request.inputPath = cliArgs.inputPath;
+  request.inputPaths = cliArgs.inputPaths;
   request.fromTimestamp = cliArgs.from;
   request.toTimestamp = cliArgs.to;
   request.keyword = cliArgs.keyword;
+  request.topErrorCount = cliArgs.topErrorCount;
+  request.topErrorCapacity = cliArgs.topErrorCapacity;
+  request.io = cliArgs.io;
+  request.mapPopulate = cliArgs.mapPopulate;
+  request.mapHugePages = cliArgs.mapHugePages;
+  request.mapBudget = cliArgs.mapBudget;
 
   // Run application
   Application app;
@@ -145,8 +255,8 @@ int main(int argc, char *argv[]) {
 
   // Render report
   std::string reportText = TextReportRenderer::render(
-      result.analysisResult, cliArgs.inputPath, getCurrentTimestamp(),
-      buildFiltersDescription(cliArgs));
+      result.analysisResult, joinInputs(cliArgs.inputPaths),
+      getCurrentTimestamp(), buildFiltersDescription(cliArgs));
 
   // Write report
   FileWriter writer(cliArgs.reportPath);
@@ -162,5 +272,9 @@ int main(int argc, char *argv[]) {
 
   std::cout << "Analysis complete. Report written to: " << cliArgs.reportPath
             << "\n";
+
+  if (cliArgs.printStats) {
+    printWorkerStats(result.analysisResult);
+  }
   return 0;
 }
@@ -1,9 +1,28 @@
 #include "TextReportRenderer.h"
-#include <iomanip>
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 namespace loganalyzer {
 
+namespace {
+
+const char *parseErrorName(ParseErrorCode code) {
+  switch (code) {
+  case ParseErrorCode::BadFormat:
+    return "BadFormat";
+  case ParseErrorCode::BadTimestamp:
+    return "BadTimestamp";
+  case ParseErrorCode::BadLevel:
+    return "BadLevel";
+  case ParseErrorCode::MissingMessage:
+    return "MissingMessage";
+  }
+  return "Unknown";
+}
+
+} // namespace
+
 std::string TextReportRenderer::render(const AnalysisResult &result,
                                        const std::string &inputPath,
                                        const std::string &runTimestamp,
@@ -26,26 +45,49 @@ std::string TextReportRenderer::render(const AnalysisResult &result,
   oss << "Invalid lines: " << result.invalidLines << "\n";
   oss << "\n";
 
+  // Per-file breakdown, in input order
+  const bool multiFile = result.files.size() > 1;
+  if (multiFile) {
+    oss << "--- Files ---\n";
+    for (const auto &file : result.files) {
+      oss << file.path << ": " << file.totalLines << " lines, "
+          << file.parsedLines << " parsed, " << file.invalidLines
+          << " invalid, " << file.bytes << " bytes\n";
+    }
+    oss << "\n";
+  }
+
   // Parse Errors (deterministic order via map)
   if (!result.parseErrors.empty()) {
     oss << "--- Parse Errors ---\n";
     for (const auto &[code, count] : result.parseErrors) {
-      std::string codeName;
-      switch (code) {
-      case ParseErrorCode::BadFormat:
-        codeName = "BadFormat";
-        break;
-      case ParseErrorCode::BadTimestamp:
-        codeName = "BadTimestamp";
-        break;
-      case ParseErrorCode::BadLevel:
-        codeName = "BadLevel";
-        break;
-      case ParseErrorCode::MissingMessage:
-        codeName = "MissingMessage";
-        break;
+      oss << parseErrorName(code) << ": " << count << "\n";
+    }
+    oss << "\n";
+  }
+
+  // Parse Error Samples (in input order)
+  if (!result.errorSamples.empty()) {
+    oss << "--- Parse Error Samples ---\n";
+    for (const auto &[code, samples] : result.errorSamples) {
+      std::vector<const AnalysisResult::ErrorSample *> ordered;
+      for (const auto &sample : samples)
+        ordered.push_back(&sample);
+      std::sort(ordered.begin(), ordered.end(),
+                [](const auto *a, const auto *b) {
+                  if (a->file != b->file)
+                    return a->file < b->file;
+                  return a->offset < b->offset;
+                });
+
+      oss << parseErrorName(code) << ":\n";
+      for (const auto *sample : ordered) {
+        oss << "  ";
+        if (multiFile && sample->file < result.files.size())
+          oss << result.files[sample->file].path << ": ";
+        oss << "line " << sample->lineNumber << " (byte " << sample->offset
+            << "): " << sample->line << "\n";
       }
-      oss << codeName << ": " << count << "\n";
     }
     oss << "\n";
   }
@@ -87,11 +129,16 @@ std::string TextReportRenderer::render(const AnalysisResult &result,
 
   // Top Errors
   if (!result.topErrors.empty()) {
-    oss << "--- Top 10 ERROR Messages ---\n";
-    int rank = 1;
-    for (const auto &[message, count] : result.topErrors) {
-      oss << rank << ". " << message << " (" << count << ")\n";
-      rank++;
+    // Bounded mode: each count is an upper bound, shown as a range
+    const bool approximate = !result.topErrorBounds.empty();
+    oss << "--- Top " << result.topErrorLimit << " ERROR Messages"
+        << (approximate ? " (approximate)" : "") << " ---\n";
+    for (size_t i = 0; i < result.topErrors.size(); ++i) {
+      const auto &[message, count] = result.topErrors[i];
+      oss << i + 1 << ". " << message << " (";
+      if (approximate && result.topErrorBounds[i] > 0)
+        oss << count - result.topErrorBounds[i] << "-";
+      oss << count << ")\n";
     }
     oss << "\n";
   }
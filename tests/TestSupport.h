@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../analysis/AnalysisResult.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace loganalyzer {
+
+// Temporary file with the given contents, removed when the test ends. The
+// name comes from mkstemps, so concurrent test runs never share a file.
+struct TempFile {
+  std::filesystem::path path;
+
+  explicit TempFile(const std::string &contents,
+                    const std::string &suffix = ".log") {
+    std::string name =
+        (std::filesystem::temp_directory_path() / "loganalyzer_XXXXXX")
+            .string() +
+        suffix;
+    const int fd = ::mkstemps(name.data(), static_cast<int>(suffix.size()));
+    REQUIRE(fd >= 0);
+    ::close(fd);
+    path = name;
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+  }
+  ~TempFile() { std::filesystem::remove(path); }
+
+  TempFile(const TempFile &) = delete;
+  TempFile &operator=(const TempFile &) = delete;
+};
+
+// Temporary directory from mkdtemp, removed with its contents
+struct TempDir {
+  std::filesystem::path path;
+
+  TempDir() {
+    std::string name =
+        (std::filesystem::temp_directory_path() / "loganalyzer_XXXXXX")
+            .string();
+    REQUIRE(::mkdtemp(name.data()) != nullptr);
+    path = name;
+  }
+  ~TempDir() { std::filesystem::remove_all(path); }
+
+  TempDir(const TempDir &) = delete;
+  TempDir &operator=(const TempDir &) = delete;
+
+  // Creates name inside the directory with the given contents
+  std::string add(const std::string &name, const std::string &contents = "") {
+    auto file = path / name;
+    std::ofstream(file, std::ios::binary) << contents;
+    return file.string();
+  }
+};
+
+// FIFO in its own temporary directory, fed by a writer thread
+struct TempFifo {
+  TempDir dir;
+  std::filesystem::path path;
+  std::thread writer;
+
+  explicit TempFifo(std::string contents) : path(dir.path / "log.fifo") {
+    REQUIRE(::mkfifo(path.c_str(), 0600) == 0);
+    writer = std::thread([p = path, data = std::move(contents)] {
+      std::ofstream out(p, std::ios::binary);
+      out << data;
+    });
+  }
+  ~TempFifo() { writer.join(); }
+};
+
+// Checks that two runs over the same input agree on everything they report
+inline void requireSameResult(const AnalysisResult &a,
+                              const AnalysisResult &b) {
+  CHECK(a.totalLines == b.totalLines);
+  CHECK(a.parsedLines == b.parsedLines);
+  CHECK(a.invalidLines == b.invalidLines);
+  CHECK(a.parseErrors == b.parseErrors);
+  CHECK(a.levelCounts == b.levelCounts);
+  CHECK(a.heatmap == b.heatmap);
+  CHECK(a.topErrors == b.topErrors);
+
+  REQUIRE(a.timeline.size() == b.timeline.size());
+  for (size_t i = 0; i < a.timeline.size(); ++i) {
+    CHECK(a.timeline[i].timestamp == b.timeline[i].timestamp);
+    CHECK(a.timeline[i].errorCount == b.timeline[i].errorCount);
+    CHECK(a.timeline[i].warningCount == b.timeline[i].warningCount);
+  }
+
+  REQUIRE(a.errorSamples.size() == b.errorSamples.size());
+  for (const auto &[code, samples] : a.errorSamples) {
+    const auto &other = b.errorSamples.at(code);
+    REQUIRE(other.size() == samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+      CHECK(other[i].file == samples[i].file);
+      CHECK(other[i].offset == samples[i].offset);
+      CHECK(other[i].lineNumber == samples[i].lineNumber);
+      CHECK(other[i].line == samples[i].line);
+    }
+  }
+}
+
+} // namespace loganalyzer
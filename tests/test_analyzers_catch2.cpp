@@ -1,9 +1,12 @@
+#include "../analysis/BoundedTopErrorAnalyzer.h"
 #include "../analysis/KeywordHitAnalyzer.h"
 #include "../analysis/LevelCountAnalyzer.h"
+#include "../analysis/QueryPlan.h"
 #include "../analysis/TimeRangeFilter.h"
 #include "../analysis/TopErrorAnalyzer.h"
 #include "../core/LogEntry.h"
 #include "../external/catch2/catch_amalgamated.hpp"
+#include <string>
 
 using namespace loganalyzer;
 
@@ -96,6 +99,7 @@ TEST_CASE("TopErrorAnalyzer deterministic sorting", "[analyzer][determinism]") {
   analyzer.process(e3);
   analyzer.process(e4);
   analyzer.finalize(result);
+  result.selectTopErrors();
 
   REQUIRE(result.topErrors.size() == 2);
 
@@ -122,6 +126,7 @@ TEST_CASE("TopErrorAnalyzer bounded map strategy", "[analyzer][determinism]") {
     }
 
     analyzer.finalize(result);
+    result.selectTopErrors();
 
     // Should only have top 10
     CHECK(result.topErrors.size() == 10);
@@ -133,3 +138,275 @@ TEST_CASE("TopErrorAnalyzer bounded map strategy", "[analyzer][determinism]") {
     CHECK(result.topErrors[9].second == 6);
   }
 }
+
+TEST_CASE("TopErrorAnalyzer owns its keys and counts many messages",
+          "[analyzer][determinism]") {
+  TopErrorAnalyzer analyzer;
+  AnalysisResult result;
+
+  // The input buffer is overwritten after each line, like a released
+  // stream block; the table grows many times over
+  std::string buffer;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 20000; ++i) {
+      buffer = "error " + std::to_string(i % 5000);
+      LogEntry e = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", buffer};
+      analyzer.process(e);
+      buffer.assign(buffer.size(), '#');
+    }
+  }
+  LogEntry warning = {{2026, 1, 5, 10, 30, 15}, LogLevel::WARNING, "", "x"};
+  analyzer.process(warning);
+
+  CHECK(analyzer.distinctMessages() == 5000);
+  analyzer.finalize(result);
+  result.selectTopErrors();
+
+  // Every message seen 12 times: alphabetical order decides
+  REQUIRE(result.topErrors.size() == TopErrorAnalyzer::kDefaultTopN);
+  CHECK(result.topErrors[0].first == "error 0");
+  CHECK(result.topErrors[1].first == "error 1");
+  CHECK(result.topErrors[2].first == "error 10");
+  CHECK(result.topErrors[3].first == "error 100");
+  for (const auto &[message, count] : result.topErrors)
+    CHECK(count == 12);
+}
+
+TEST_CASE("Merged top errors are exact", "[analyzer][determinism]") {
+  // Per thread, "rare" is 11th after ten local messages with more hits,
+  // but over all threads it is first
+  AnalysisResult merged;
+  for (int thread = 0; thread < 4; ++thread) {
+    TopErrorAnalyzer analyzer;
+    for (int m = 0; m < 10; ++m) {
+      std::string message = "local " + std::to_string(thread * 10 + m);
+      for (int i = 0; i < 5; ++i) {
+        LogEntry e = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", message};
+        analyzer.process(e);
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      LogEntry e = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", "rare"};
+      analyzer.process(e);
+    }
+    AnalysisResult partial;
+    analyzer.finalize(partial);
+    partial.selectTopErrors();
+    CHECK(partial.topErrors.size() == 10);
+    CHECK(partial.topErrors.back().first != "rare");
+    merged.merge(partial);
+  }
+  merged.selectTopErrors();
+
+  REQUIRE(merged.topErrors.size() == 10);
+  CHECK(merged.topErrors[0] == std::make_pair(std::string("rare"),
+                                              uint64_t{16}));
+  CHECK(merged.topErrors[1].second == 5);
+  CHECK(merged.errorCounts.size() == 41);
+}
+
+TEST_CASE("TopErrorAnalyzer lists a configurable number of messages",
+          "[analyzer]") {
+  TopErrorAnalyzer analyzer(3);
+  for (int i = 0; i < 20; ++i) {
+    std::string message = "error " + std::to_string(i % 5);
+    LogEntry e = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", message};
+    analyzer.process(e);
+  }
+  AnalysisResult result;
+  analyzer.finalize(result);
+  result.selectTopErrors();
+  CHECK(result.topErrorLimit == 3);
+  CHECK(result.topErrors.size() == 3);
+  CHECK(result.errorCounts.size() == 5);
+}
+
+TEST_CASE("BoundedTopErrorAnalyzer finds heavy hitters in fixed memory",
+          "[analyzer]") {
+  // 2000 unique messages around three frequent ones, with 64 counters
+  BoundedTopErrorAnalyzer analyzer(64, 3);
+  for (int i = 0; i < 2000; ++i) {
+    std::string unique = "request " + std::to_string(i) + " failed";
+    LogEntry e = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", unique};
+    analyzer.process(e);
+    if (i % 10 == 0) {
+      LogEntry hot = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", "db down"};
+      analyzer.process(hot);
+    }
+    if (i % 20 == 0) {
+      LogEntry warm = {
+          {2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", "disk full"};
+      analyzer.process(warm);
+    }
+  }
+  AnalysisResult result;
+  analyzer.finalize(result);
+  result.selectTopErrors();
+
+  CHECK(result.errorSketch.counters.size() == 64);
+  REQUIRE(result.topErrors.size() == 3);
+  REQUIRE(result.topErrorBounds.size() == 3);
+  CHECK(result.topErrors[0].first == "db down");
+  CHECK(result.topErrors[1].first == "disk full");
+  // Never undercounted, overcounted by at most the bound
+  CHECK(result.topErrors[0].second >= 200);
+  CHECK(result.topErrors[0].second - result.topErrorBounds[0] <= 200);
+  CHECK(result.topErrors[1].second >= 100);
+  CHECK(result.topErrors[1].second - result.topErrorBounds[1] <= 100);
+}
+
+TEST_CASE("Merged bounded top errors keep their bounds", "[analyzer]") {
+  AnalysisResult merged;
+  for (int thread = 0; thread < 4; ++thread) {
+    BoundedTopErrorAnalyzer analyzer(16, 5);
+    for (int i = 0; i < 500; ++i) {
+      std::string unique = "id " + std::to_string(thread * 500 + i);
+      LogEntry e = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", unique};
+      analyzer.process(e);
+      if (i % 5 == 0) {
+        LogEntry hot = {{2026, 1, 5, 10, 30, 15}, LogLevel::ERROR, "", "hot"};
+        analyzer.process(hot);
+      }
+    }
+    AnalysisResult partial;
+    analyzer.finalize(partial);
+    merged.merge(partial);
+  }
+  merged.selectTopErrors();
+
+  CHECK(merged.errorSketch.counters.size() <= 16);
+  REQUIRE(!merged.topErrors.empty());
+  CHECK(merged.topErrors.size() == merged.topErrorBounds.size());
+  CHECK(merged.topErrors[0].first == "hot");
+  CHECK(merged.topErrors[0].second >= 400);
+  CHECK(merged.topErrors[0].second - merged.topErrorBounds[0] <= 400);
+  // Unique messages occurred once; their ranges must include that
+  for (size_t i = 1; i < merged.topErrors.size(); ++i) {
+    CHECK(merged.topErrors[i].second >= 1);
+    CHECK(merged.topErrors[i].second - merged.topErrorBounds[i] <= 1);
+  }
+}
+
+TEST_CASE("QueryPlan requests only the fields in use", "[analyzer][plan]") {
+  AnalysisContext context;
+
+  SECTION("Default run needs everything") {
+    QueryPlan plan = QueryPlan::build(context);
+    CHECK(plan.fields.timestamp);
+    CHECK(plan.fields.level);
+    CHECK(plan.fields.message);
+    CHECK(plan.timeline);
+  }
+
+  SECTION("Level counts only") {
+    context.topErrors = false;
+    context.timeline = false;
+    QueryPlan plan = QueryPlan::build(context);
+    CHECK_FALSE(plan.fields.timestamp);
+    CHECK(plan.fields.level);
+    CHECK_FALSE(plan.fields.message);
+    CHECK(QueryPlan::makeAnalyzers(context).size() == 1);
+  }
+
+  SECTION("Time range plus keyword") {
+    context.countLevels = false;
+    context.topErrors = false;
+    context.timeline = false;
+    context.fromTs = Timestamp(2026, 1, 5);
+    context.keyword = "timeout";
+    QueryPlan plan = QueryPlan::build(context);
+    CHECK(plan.fields.timestamp);
+    CHECK_FALSE(plan.fields.level);
+    CHECK(plan.fields.message);
+  }
+}
+
+TEST_CASE("QueryPlan composes analyzers statically where it can",
+          "[analyzer][plan]") {
+  AnalysisContext context;
+  context.keyword = "timeout";
+
+  // Every combination of the three analyzers
+  for (int mask = 0; mask < 8; ++mask) {
+    context.countLevels = mask & 1;
+    context.topErrors = mask & 2;
+    if (mask & 4) {
+      context.keyword = "timeout";
+    } else {
+      context.keyword.reset();
+    }
+
+    auto set = QueryPlan::makeAnalyzerSet(context);
+    auto dynamic = QueryPlan::makeAnalyzers(context);
+    const bool isStatic = !std::holds_alternative<DynamicAnalyzerSet>(set);
+    // Level counts with optional top errors and keyword, or nothing
+    CHECK(isStatic == (mask == 0 || mask == 1 || mask == 3 || mask == 7));
+
+    AnalysisResult a;
+    AnalysisResult b;
+    for (int i = 0; i < 20; ++i) {
+      LogEntry e = {{2026, 1, 5, 10, 30, 15},
+                    i % 3 ? LogLevel::INFO : LogLevel::ERROR,
+                    "",
+                    i % 2 ? "db timeout" : "disk full"};
+      std::visit([&](auto &analyzers) { analyzers.process(e); }, set);
+      for (auto &analyzer : dynamic)
+        analyzer->process(e);
+    }
+    std::visit([&](auto &analyzers) { analyzers.finalize(a); }, set);
+    for (auto &analyzer : dynamic)
+      analyzer->finalize(b);
+    a.selectTopErrors();
+    b.selectTopErrors();
+
+    CHECK(a.levelCounts == b.levelCounts);
+    CHECK(a.topErrors == b.topErrors);
+    CHECK(a.keywordHits == b.keywordHits);
+  }
+}
+
+TEST_CASE("AnalysisResult keeps bounded parse error samples",
+          "[analyzer][samples]") {
+  const size_t kLimit = AnalysisResult::kMaxErrorSamples;
+
+  SECTION("At most kMaxErrorSamples per code") {
+    AnalysisResult result;
+    for (uint64_t i = 0; i < 1000; ++i) {
+      result.addErrorSample(ParseErrorCode::BadFormat, i * 10, i + 1, "junk");
+    }
+    result.addErrorSample(ParseErrorCode::BadLevel, 7, 1, "[x] [DEBUG] y");
+    CHECK(result.errorSamples[ParseErrorCode::BadFormat].size() == kLimit);
+    CHECK(result.errorSamples[ParseErrorCode::BadLevel].size() == 1);
+  }
+
+  SECTION("Merging split results gives the same samples") {
+    AnalysisResult whole, left, right;
+    for (uint64_t i = 0; i < 500; ++i) {
+      std::string line = "line " + std::to_string(i);
+      whole.addErrorSample(ParseErrorCode::BadFormat, i * 32, i + 1, line);
+      (i < 200 ? left : right)
+          .addErrorSample(ParseErrorCode::BadFormat, i * 32, i + 1, line);
+    }
+    left.merge(right);
+
+    const auto &a = whole.errorSamples[ParseErrorCode::BadFormat];
+    const auto &b = left.errorSamples[ParseErrorCode::BadFormat];
+    REQUIRE(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+      CHECK(a[i].offset == b[i].offset);
+      CHECK(a[i].line == b[i].line);
+    }
+  }
+
+  SECTION("Sample text is truncated and sanitized") {
+    AnalysisResult result;
+    std::string binary(1000, 'x');
+    binary[3] = '\0';
+    binary[5] = '\x1b';
+    result.addErrorSample(ParseErrorCode::BadFormat, 0, 1, binary);
+
+    const auto &sample = result.errorSamples[ParseErrorCode::BadFormat][0];
+    CHECK(sample.line.size() == AnalysisResult::kMaxSampleLength);
+    CHECK(sample.line.substr(0, 6) == "xxx?x?");
+  }
+}
@@ -0,0 +1,225 @@
+#include "../analysis/Pipeline.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "../io/Decompressor.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <string>
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace loganalyzer;
+
+TEST_CASE("Decompressor detects formats by magic bytes", "[decompress]") {
+  CHECK(Decompressor::detect("\x1f\x8b\x08") == Compression::Gzip);
+  CHECK(Decompressor::detect("\x28\xb5\x2f\xfd") == Compression::Zstd);
+  CHECK(Decompressor::detect("[2026-01-05 10:30:15]") == Compression::None);
+  CHECK(Decompressor::detect("\x1f") == Compression::None);
+  CHECK(Decompressor::create(Compression::None) == nullptr);
+}
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+
+namespace {
+
+std::string makeText(size_t size) {
+  std::string text;
+  for (int i = 0; text.size() < size; ++i) {
+    text += "[2026-01-05 10:30:" + std::to_string(10 + i % 50) + "] [" +
+            (i % 7 == 0 ? "garbage" : "ERROR") + "] Event " +
+            std::to_string(i % 333) + "\n";
+  }
+  return text;
+}
+
+// Deflates data; raw deflate for windowBits < 0, gzip for 15 + 16
+std::string deflateData(const std::string &data, int windowBits) {
+  z_stream zs{};
+  REQUIRE(deflateInit2(&zs, 6, Z_DEFLATED, windowBits, 8,
+                       Z_DEFAULT_STRATEGY) == Z_OK);
+  std::string out(deflateBound(&zs, data.size()), '\0');
+  zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  zs.avail_in = static_cast<uInt>(data.size());
+  zs.next_out = reinterpret_cast<Bytef *>(out.data());
+  zs.avail_out = static_cast<uInt>(out.size());
+  REQUIRE(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+  return out;
+}
+
+std::string gzip(const std::string &data) { return deflateData(data, 31); }
+
+void appendLe(std::string &out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i)
+    out += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+// The BGZF layout bgzip writes: 64 KB members with a "BC" size field,
+// ending in an empty member
+std::string bgzip(const std::string &data) {
+  std::string out;
+  for (size_t pos = 0;; pos += 0xff00) {
+    std::string block = data.substr(std::min(pos, data.size()), 0xff00);
+    std::string deflated = deflateData(block, -15);
+    // Magic, deflate, FEXTRA, no mtime, XFL, OS, XLEN = 6, "BC" of size 2
+    out += std::string("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+    appendLe(out, static_cast<uint32_t>(deflated.size() + 25), 2);
+    out += deflated;
+    appendLe(out, crc32(0, reinterpret_cast<const Bytef *>(block.data()),
+                        static_cast<uInt>(block.size())),
+             4);
+    appendLe(out, static_cast<uint32_t>(block.size()), 4);
+    if (block.empty())
+      break; // End-of-file marker
+  }
+  return out;
+}
+
+// Feeds data in pieces of the given size and collects the output
+std::string decompressAll(Decompressor &decompressor, const std::string &data,
+                          size_t piece) {
+  std::string out;
+  std::string buffered;
+  size_t fed = 0;
+  char buffer[1000];
+  while (!decompressor.failed()) {
+    std::string_view input(buffered);
+    size_t n = decompressor.decompress(input, buffer, sizeof(buffer));
+    buffered.erase(0, buffered.size() - input.size());
+    out.append(buffer, n);
+    if (n == 0) {
+      if (fed == data.size())
+        break;
+      buffered.append(data, fed, piece);
+      fed = std::min(fed + piece, data.size());
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+TEST_CASE("Decompressor inflates gzip fed in small pieces", "[decompress]") {
+  const std::string text = makeText(300 * 1024);
+  auto decompressor = Decompressor::create(Compression::Gzip);
+  REQUIRE(decompressor);
+
+  CHECK(decompressAll(*decompressor, gzip(text), 777) == text);
+  CHECK_FALSE(decompressor->failed());
+  CHECK(decompressor->finished());
+}
+
+TEST_CASE("Decompressor inflates concatenated gzip members", "[decompress]") {
+  const std::string a = makeText(50 * 1024);
+  const std::string b = makeText(70 * 1024);
+  auto decompressor = Decompressor::create(Compression::Gzip);
+
+  CHECK(decompressAll(*decompressor, gzip(a) + gzip(b) + gzip(a), 4096) ==
+        a + b + a);
+  CHECK(decompressor->finished());
+}
+
+TEST_CASE("Decompressor inflates BGZF members in parallel", "[decompress]") {
+  const std::string text = makeText(3 * 1024 * 1024);
+  const std::string compressed = bgzip(text);
+  auto decompressor = Decompressor::create(Compression::Gzip, 4);
+
+  // Whole members arrive together only with large pieces
+  CHECK(decompressAll(*decompressor, compressed, 512 * 1024) == text);
+  CHECK(decompressor->finished());
+
+  // BGZF followed by a plain member
+  auto mixed = Decompressor::create(Compression::Gzip, 4);
+  CHECK(decompressAll(*mixed, compressed + gzip("tail\n"), 10000) ==
+        text + "tail\n");
+}
+
+TEST_CASE("Decompressor reuses its helpers over many BGZF batches",
+          "[decompress]") {
+  // Several output batches of 4 MB, then zero padding
+  const std::string text = makeText(10 * 1024 * 1024);
+  auto decompressor = Decompressor::create(Compression::Gzip, 4);
+
+  CHECK(decompressAll(*decompressor, bgzip(text) + std::string(10, '\0'),
+                      1024 * 1024) == text);
+  CHECK_FALSE(decompressor->failed());
+  CHECK(decompressor->finished());
+}
+
+TEST_CASE("Decompressor ignores zero padding after the last member",
+          "[decompress]") {
+  const std::string text = makeText(20 * 1024);
+
+  auto padded = Decompressor::create(Compression::Gzip);
+  CHECK(decompressAll(*padded, gzip(text) + std::string(512, '\0'), 100) ==
+        text);
+  CHECK_FALSE(padded->failed());
+  CHECK(padded->finished());
+
+  // Only at the end: a member after the padding is an error
+  auto middle = Decompressor::create(Compression::Gzip);
+  decompressAll(*middle, gzip(text) + std::string(8, '\0') + gzip(text),
+                100000);
+  CHECK(middle->failed());
+}
+
+TEST_CASE("Decompressor reports corrupt and truncated gzip",
+          "[decompress]") {
+  const std::string text = makeText(200 * 1024);
+
+  std::string corrupt = bgzip(text);
+  corrupt[corrupt.size() / 2] ^= 0x55;
+  auto decompressor = Decompressor::create(Compression::Gzip, 2);
+  decompressAll(*decompressor, corrupt, corrupt.size());
+  CHECK(decompressor->failed());
+  CHECK_FALSE(decompressor->error().empty());
+
+  std::string truncated = gzip(text);
+  truncated.resize(truncated.size() / 2);
+  auto partial = Decompressor::create(Compression::Gzip);
+  decompressAll(*partial, truncated, 1000);
+  CHECK_FALSE(partial->failed());
+  CHECK_FALSE(partial->finished());
+}
+
+TEST_CASE("Pipeline analyzes gzip files like the uncompressed log",
+          "[decompress][pipeline]") {
+  const std::string text = makeText(9 * 1024 * 1024);
+  TempFile plain(text, ".log");
+  TempFile gz(gzip(text), ".log.gz");
+  TempFile bgz(bgzip(text), ".log.bgz");
+
+  AnalysisContext context;
+  context.threads = 3;
+  AnalysisResult expected = Pipeline::run(plain.path.string(), context);
+  AnalysisResult fromGzip = Pipeline::run(gz.path.string(), context);
+  AnalysisResult fromBgzf = Pipeline::run(bgz.path.string(), context);
+
+  REQUIRE(expected.totalLines > 0);
+  requireSameResult(expected, fromGzip);
+  requireSameResult(expected, fromBgzf);
+  REQUIRE(fromGzip.files.size() == 1);
+  CHECK(fromGzip.files.front().bytes == text.size());
+
+  // Mixed with a mapped file, in input order
+  AnalysisResult mixed = Pipeline::run(
+      std::vector<std::string>{gz.path.string(), plain.path.string()},
+      context);
+  REQUIRE(mixed.files.size() == 2);
+  CHECK(mixed.files[0].path == gz.path.string());
+  CHECK(mixed.files[1].path == plain.path.string());
+  CHECK(mixed.totalLines == 2 * expected.totalLines);
+}
+
+TEST_CASE("Pipeline rejects a truncated gzip file", "[decompress][pipeline]") {
+  std::string compressed = gzip(makeText(100 * 1024));
+  compressed.resize(compressed.size() - 100);
+  TempFile gz(compressed, ".log.gz");
+
+  CHECK_THROWS_WITH(Pipeline::run(gz.path.string(), AnalysisContext{}),
+                    Catch::Matchers::ContainsSubstring("Truncated gzip"));
+}
+
+#endif // LOGANALYZER_HAVE_ZLIB
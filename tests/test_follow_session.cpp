@@ -0,0 +1,100 @@
+#include "../analysis/FollowSession.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "TestSupport.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace loganalyzer;
+
+namespace {
+
+void append(const std::filesystem::path &path, const std::string &text) {
+  std::ofstream out(path, std::ios::binary | std::ios::app);
+  out << text;
+}
+
+// Lines first..last-1, a few of them invalid
+std::string makeLines(int first, int last) {
+  static const char *kLevels[] = {"INFO", "WARNING", "ERROR"};
+  std::string text;
+  char buf[96];
+  for (int i = first; i < last; ++i) {
+    if (i % 37 == 0) {
+      text += "not a log line " + std::to_string(i) + "\n";
+      continue;
+    }
+    std::snprintf(buf, sizeof(buf),
+                  "[2026-01-05 %02d:%02d:%02d] [%s] Event %d\n", i / 3600 % 24,
+                  i / 60 % 60, i % 60, kLevels[i % 3], i % 7);
+    text += buf;
+  }
+  return text;
+}
+
+} // namespace
+
+TEST_CASE("FollowSession merges appended lines like a full run",
+          "[follow]") {
+  TempFile file("");
+  const auto &path = file.path;
+  append(path, makeLines(0, 1000));
+
+  FollowSession session(path.string(), AnalysisContext{});
+  CHECK(session.update() == FollowSession::Update::Restarted);
+  CHECK(session.lines() == 1000);
+  CHECK(session.update() == FollowSession::Update::Unchanged);
+
+  // The half-written last line is left for the next update
+  std::string more = makeLines(1000, 2500);
+  size_t split = more.size() - 10;
+  append(path, more.substr(0, split));
+  CHECK(session.update() == FollowSession::Update::Appended);
+  CHECK(session.lines() == 2499);
+
+  append(path, more.substr(split));
+  CHECK(session.update() == FollowSession::Update::Appended);
+  CHECK(session.offset() == std::filesystem::file_size(path));
+
+  requireSameResult(session.result(),
+                    Pipeline::run(path.string(), AnalysisContext{}));
+}
+
+TEST_CASE("FollowSession restarts after truncation and rotation",
+          "[follow]") {
+  TempFile file("");
+  const auto &path = file.path;
+  append(path, makeLines(0, 2000));
+
+  FollowSession session(path.string(), AnalysisContext{});
+  session.update();
+  REQUIRE(session.lines() == 2000);
+
+  size_t newLines = 300;
+  SECTION("Truncated") {
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        << makeLines(5000, 5300);
+    CHECK(session.update() == FollowSession::Update::Restarted);
+  }
+
+  SECTION("Truncated and grown past the old size between updates") {
+    std::ofstream(path, std::ios::binary | std::ios::trunc)
+        << makeLines(5000, 8000);
+    CHECK(session.update() == FollowSession::Update::Restarted);
+    newLines = 3000;
+  }
+
+  SECTION("Rotated") {
+    auto rotated = path;
+    rotated += ".1";
+    std::filesystem::rename(path, rotated);
+    append(path, makeLines(5000, 5300));
+    CHECK(session.update() == FollowSession::Update::Restarted);
+    std::filesystem::remove(rotated);
+  }
+
+  CHECK(session.lines() == newLines);
+  requireSameResult(session.result(),
+                    Pipeline::run(path.string(), AnalysisContext{}));
+}
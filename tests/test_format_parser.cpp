@@ -0,0 +1,154 @@
+#include "../core/FormatParser.h"
+#include "../core/FormatRegistry.h"
+#include "../core/PatternLogParser.h"
+#include "../core/StandardLogParser.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include <string_view>
+#include <variant>
+#include <vector>
+
+using namespace loganalyzer;
+
+TEST_CASE("FormatParser parses the standard layout", "[Parser][Format]") {
+  FormatParser<"[%D %T] [%L] %M"> parser;
+
+  auto result = parser.parse("[2026-01-05 10:30:15] [ERROR] Disk full", 1);
+  REQUIRE(std::holds_alternative<LogEntry>(result));
+  auto entry = std::get<LogEntry>(result);
+  CHECK(entry.ts.year() == 2026);
+  CHECK(entry.ts.minute() == 30);
+  CHECK(entry.level == LogLevel::ERROR);
+  CHECK(entry.message == "Disk full");
+
+  auto bad = parser.parse("[2026-01-05 10:30:15] ERROR Disk full", 2);
+  REQUIRE(std::holds_alternative<ParseError>(bad));
+  CHECK(std::get<ParseError>(bad).code == ParseErrorCode::BadFormat);
+  CHECK(std::holds_alternative<ParseError>(parser.parse("", 3)));
+}
+
+TEST_CASE("FormatParser agrees with PatternLogParser", "[Parser][Format]") {
+  const char *lines[] = {
+      "[2026-01-05 10:30:15] [INFO] started",
+      "[2026-01-05 10:30:15.123] [WARN] slow",
+      "[2026/01/05 10:30:15] [ERR] slash date",
+      "[2026-01-05 10:30:15] [INFO]",
+      "[2026-01-05 10:30:15] [INFO] ",
+      "2026-01-05 10:30:15 [WARNING] bracketed level",
+      "2026-01-05 10:30:15 ERROR plain level",
+      "2026-01-05 10:30:15 ERROR",
+      "2026-01-05 10:30:15  ERROR double space",
+      "garbage",
+      "",
+  };
+
+  auto compare = [&](const ILogParser &specialized, const char *pattern) {
+    PatternLogParser reference(pattern);
+    for (const char *line : lines) {
+      INFO("pattern: " << pattern << " line: " << line);
+      auto a = specialized.parse(line, 1);
+      auto b = reference.parse(line, 1);
+      REQUIRE(a.index() == b.index());
+      if (auto *ea = std::get_if<LogEntry>(&a)) {
+        const auto &eb = std::get<LogEntry>(b);
+        CHECK(ea->level == eb.level);
+        CHECK(ea->message == eb.message);
+        CHECK(ea->ts == eb.ts);
+      }
+    }
+  };
+
+  compare(FormatParser<"[%D %T] [%L] %M">(), "[%D %T] [%L] %M");
+  compare(FormatParser<"%D %T [%L] %M">(), "%D %T [%L] %M");
+  compare(FormatParser<"%D %T %L %M">(), "%D %T %L %M");
+  compare(FormatParser<"<%L> %M (end)">(), "<%L> %M (end)");
+}
+
+TEST_CASE("FormatParser and PatternLogParser honour requested fields",
+          "[Parser][Format]") {
+  const char *line = "[2026-01-05 10:30:15] [ERROR] Disk full";
+  auto check = [&](ILogParser &parser) {
+    parser.setFields({false, true, false});
+    auto result = parser.parse(line, 1);
+    REQUIRE(std::holds_alternative<LogEntry>(result));
+    const auto &entry = std::get<LogEntry>(result);
+    CHECK_FALSE(entry.ts.isValid());
+    CHECK(entry.level == LogLevel::ERROR);
+    CHECK(entry.message.empty());
+
+    // Unrequested fields still have to match the layout
+    CHECK(std::holds_alternative<ParseError>(parser.parse("garbage", 2)));
+    CHECK(std::holds_alternative<ParseError>(
+        parser.parse("[2026-01-05 10:30:15] [ERROR] a\rb", 3)));
+  };
+
+  FormatParser<"[%D %T] [%L] %M"> specialized;
+  PatternLogParser runtime("[%D %T] [%L] %M");
+  check(specialized);
+  check(runtime);
+}
+
+TEST_CASE("parseBatch agrees with parse", "[Parser][Batch]") {
+  const std::vector<std::string_view> lines = {
+      "[2026-01-05 10:30:15] [ERROR] Disk full",
+      "[2026-01-05 10:30:16] [WARNING] Slow query",
+      "garbage",
+      "[2026-02-31 10:30:17] [INFO] Bad date",
+      "[2026-01-05 10:30:18] [DEBUG] Unknown level",
+      "[2026-01-05 10:30:19] [INFO]",
+      "[2026-01-05 10:30:20] [INFO] ",
+  };
+
+  // Exercises the default ILogParser::parseBatch
+  struct Wrapper : ILogParser {
+    StandardLogParser inner;
+    ParseResult parse(std::string_view line, size_t n) const override {
+      return inner.parse(line, n);
+    }
+  };
+
+  auto compare = [&](const ILogParser &batchParser,
+                     const ILogParser &lineParser) {
+    ParsedBatch batch;
+    batchParser.parseBatch(lines, batch);
+    REQUIRE(batch.size == lines.size());
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+      INFO(lines[i]);
+      auto single = lineParser.parse(lines[i], i + 1);
+      if (const auto *entry = std::get_if<LogEntry>(&single)) {
+        REQUIRE(batch.valid[i]);
+        LogEntry fromBatch = batch.entry(i, lines[i]);
+        CHECK(fromBatch.ts == entry->ts);
+        CHECK(fromBatch.level == entry->level);
+        CHECK(fromBatch.message == entry->message);
+        CHECK(fromBatch.rawLine == lines[i]);
+      } else {
+        REQUIRE_FALSE(batch.valid[i]);
+        CHECK(batch.errors[i] == std::get<ParseError>(single).code);
+      }
+    }
+  };
+
+  compare(StandardLogParser(), StandardLogParser());
+  compare(Wrapper(), StandardLogParser());
+  compare(FormatParser<"[%D %T] [%L] %M">(),
+          FormatParser<"[%D %T] [%L] %M">());
+  compare(PatternLogParser("[%D %T] [%L] %M"),
+          PatternLogParser("[%D %T] [%L] %M"));
+  compare(PatternLogParser("[%D %T] %M] %M"),
+          PatternLogParser("[%D %T] %M] %M"));
+}
+
+TEST_CASE("FormatRegistry picks the parser implementation",
+          "[Parser][Format]") {
+  auto standard = FormatRegistry::createParser("");
+  CHECK(dynamic_cast<StandardLogParser *>(standard.get()) != nullptr);
+
+  auto specialized = FormatRegistry::createParser("[%D %T] [%L] %M");
+  CHECK(dynamic_cast<FormatParser<"[%D %T] [%L] %M"> *>(specialized.get()) !=
+        nullptr);
+  CHECK(FormatRegistry::instance().contains("%D %T %L %M"));
+
+  auto runtime = FormatRegistry::createParser("%T - %L - %M");
+  CHECK(dynamic_cast<PatternLogParser *>(runtime.get()) != nullptr);
+}
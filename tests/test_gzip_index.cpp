@@ -0,0 +1,206 @@
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "../io/GzipIndex.h"
+#include "TestSupport.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef LOGANALYZER_HAVE_ZLIB
+#include <zlib.h>
+
+using namespace loganalyzer;
+
+namespace {
+
+// Lines of varying length, some much longer than a checkpoint window
+std::vector<std::string> makeLines(size_t count) {
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < count; ++i) {
+    std::string line = "[2026-01-05 10:30:15] [INFO] Event " +
+                       std::to_string(i * 7919 % 100003);
+    if (i % 4999 == 0)
+      line += std::string(70000, 'x');
+    lines.push_back(std::move(line));
+  }
+  return lines;
+}
+
+std::string join(const std::vector<std::string> &lines, size_t begin,
+                 size_t end) {
+  std::string text;
+  for (size_t i = begin; i < end; ++i)
+    text += lines[i] + "\n";
+  return text;
+}
+
+std::string gzip(const std::string &data) {
+  z_stream zs{};
+  REQUIRE(deflateInit2(&zs, 6, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) ==
+          Z_OK);
+  std::string out(deflateBound(&zs, data.size()), '\0');
+  zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  zs.avail_in = static_cast<uInt>(data.size());
+  zs.next_out = reinterpret_cast<Bytef *>(out.data());
+  zs.avail_out = static_cast<uInt>(out.size());
+  REQUIRE(deflate(&zs, Z_FINISH) == Z_STREAM_END);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+  return out;
+}
+
+// Temporary .gz file and its index, removed when the test ends
+struct TempGz : TempFile {
+  explicit TempGz(const std::string &contents)
+      : TempFile(contents, ".log.gz") {}
+  ~TempGz() { std::filesystem::remove(GzipIndex::indexPath(path.string())); }
+};
+
+void checkLines(GzipIndex &index, const std::vector<std::string> &lines,
+                uint64_t first, size_t count) {
+  std::vector<std::string_view> got;
+  REQUIRE(index.readLines(first, count, got));
+  const size_t expected =
+      std::min<size_t>(count, lines.size() - static_cast<size_t>(first));
+  REQUIRE(got.size() == expected);
+  for (size_t i = 0; i < got.size(); ++i)
+    CHECK(got[i] == lines[first + i]);
+}
+
+} // namespace
+
+TEST_CASE("GzipIndex reads lines anywhere in the file", "[gzipindex]") {
+  const auto lines = makeLines(200000);
+  TempGz file(gzip(join(lines, 0, lines.size())));
+
+  GzipIndex index;
+  REQUIRE(index.build(file.path.string()));
+  CHECK(index.lineCount() == lines.size());
+  REQUIRE(index.checkpoints().size() > 4);
+
+  // Around every checkpoint, backwards to defeat the cache
+  for (size_t c = index.checkpoints().size(); c-- > 0;) {
+    uint64_t line = index.checkpoints()[c].firstLine;
+    checkLines(index, lines, line > 3 ? line - 3 : 0, 8);
+  }
+  checkLines(index, lines, 0, 50);
+  checkLines(index, lines, lines.size() - 10, 50);
+  checkLines(index, lines, 4999, 2);
+}
+
+TEST_CASE("GzipIndex handles concatenated members", "[gzipindex]") {
+  const auto lines = makeLines(120000);
+  const size_t split = 70001;
+  TempGz file(gzip(join(lines, 0, split)) +
+              gzip(join(lines, split, lines.size())));
+
+  GzipIndex index;
+  REQUIRE(index.build(file.path.string()));
+  CHECK(index.lineCount() == lines.size());
+  checkLines(index, lines, split - 5, 10);
+  for (size_t c = index.checkpoints().size(); c-- > 0;)
+    checkLines(index, lines, index.checkpoints()[c].firstLine, 3);
+}
+
+TEST_CASE("GzipIndex is saved and reused until the file changes",
+          "[gzipindex]") {
+  const auto lines = makeLines(150000);
+  TempGz file(gzip(join(lines, 0, lines.size())));
+
+  GzipIndex built;
+  REQUIRE(built.build(file.path.string()));
+  REQUIRE(built.save());
+
+  GzipIndex loaded;
+  REQUIRE(loaded.load(file.path.string()));
+  CHECK(loaded.lineCount() == built.lineCount());
+  CHECK(loaded.size() == built.size());
+  CHECK(loaded.checkpoints().size() == built.checkpoints().size());
+  checkLines(loaded, lines, lines.size() / 2, 20);
+  checkLines(loaded, lines, loaded.checkpoints().back().firstLine, 5);
+
+  // A different file size makes the index stale
+  std::ofstream(file.path, std::ios::binary | std::ios::app) << gzip("x\n");
+  GzipIndex stale;
+  CHECK_FALSE(stale.load(file.path.string()));
+}
+
+TEST_CASE("GzipIndex rejects a corrupt saved index", "[gzipindex]") {
+  const auto lines = makeLines(150000);
+  TempGz file(gzip(join(lines, 0, lines.size())));
+
+  GzipIndex built;
+  REQUIRE(built.build(file.path.string()));
+  REQUIRE(built.checkpoints().size() > 2);
+  REQUIRE(built.save());
+
+  // Header of 6 values, then the first checkpoint (at a member start, so
+  // without a window) of out, in, firstLine, bits, two flags and a size
+  const std::string indexPath = GzipIndex::indexPath(file.path.string());
+  constexpr std::streamoff kSecond = 6 * 8 + 3 * 8 + 4 + 2 + 4;
+  {
+    std::ifstream in(indexPath, std::ios::binary);
+    uint64_t secondIn = 0;
+    in.seekg(kSecond + 8);
+    in.read(reinterpret_cast<char *>(&secondIn), sizeof(secondIn));
+    REQUIRE(secondIn == built.checkpoints()[1].in);
+  }
+  auto patch = [&](std::streamoff pos, const auto &value) {
+    std::fstream out(indexPath,
+                     std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(pos);
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  };
+
+  SECTION("Unused bits before the first byte of the file") {
+    patch(kSecond + 8, uint64_t{0});
+    patch(kSecond + 24, int32_t{3});
+  }
+  SECTION("Bits out of range") { patch(kSecond + 24, int32_t{9}); }
+  SECTION("Checkpoints out of order") { patch(kSecond, uint64_t{0}); }
+  SECTION("First checkpoint after line 0") { patch(6 * 8 + 16, uint64_t{5}); }
+  SECTION("First checkpoint inside a line") {
+    patch(6 * 8 + 3 * 8 + 4 + 1, uint8_t{0});
+  }
+  SECTION("Line past the end of the file") {
+    patch(kSecond + 16, built.lineCount() + 1);
+  }
+  SECTION("More checkpoints than the file has bytes") {
+    patch(5 * 8, uint64_t{1} << 60);
+  }
+
+  GzipIndex loaded;
+  CHECK_FALSE(loaded.load(file.path.string()));
+}
+
+TEST_CASE("GzipIndex ignores zero padding after the last member",
+          "[gzipindex]") {
+  TempGz file(gzip("first\nsecond\n") + std::string(64, '\0'));
+
+  GzipIndex index;
+  REQUIRE(index.build(file.path.string()));
+  CHECK(index.lineCount() == 2);
+}
+
+TEST_CASE("GzipIndex keeps an unterminated last line", "[gzipindex]") {
+  TempGz file(gzip("first\r\nsecond\nlast"));
+
+  GzipIndex index;
+  REQUIRE(index.build(file.path.string()));
+  REQUIRE(index.lineCount() == 3);
+  std::vector<std::string_view> got;
+  REQUIRE(index.readLines(0, 10, got));
+  CHECK(got == std::vector<std::string_view>{"first", "second", "last"});
+}
+
+TEST_CASE("GzipIndex rejects a truncated file", "[gzipindex]") {
+  std::string compressed = gzip(join(makeLines(20000), 0, 20000));
+  compressed.resize(compressed.size() / 2);
+  TempGz file(compressed);
+
+  GzipIndex index;
+  CHECK_FALSE(index.build(file.path.string()));
+  CHECK_FALSE(index.error().empty());
+}
+
+#endif // LOGANALYZER_HAVE_ZLIB
@@ -0,0 +1,64 @@
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "../io/InputPaths.h"
+#include "TestSupport.h"
+#include <filesystem>
+#include <string>
+
+using namespace loganalyzer;
+
+TEST_CASE("InputPaths expands a directory to its sorted files",
+          "[inputs]") {
+  TempDir dir;
+  std::string b = dir.add("b.log");
+  std::string a = dir.add("a.log");
+  std::filesystem::create_directory(dir.path / "nested");
+
+  std::vector<std::string> files;
+  std::string error;
+  REQUIRE(InputPaths::expand({dir.path.string()}, files, error));
+  CHECK(files == std::vector<std::string>{a, b});
+}
+
+TEST_CASE("InputPaths expands globs and drops duplicates", "[inputs]") {
+  TempDir dir;
+  std::string a = dir.add("app-1.log");
+  std::string b = dir.add("app-2.log");
+  dir.add("other.txt");
+
+  std::vector<std::string> files;
+  std::string error;
+  REQUIRE(InputPaths::expand({b, (dir.path / "app-*.log").string()}, files,
+                             error));
+  CHECK(files == std::vector<std::string>{b, a});
+}
+
+TEST_CASE("InputPaths drops other spellings of the same file",
+          "[inputs]") {
+  TempDir dir;
+  std::string a = dir.add("a.log");
+  std::string b = dir.add("b.log");
+  std::filesystem::create_symlink(a, dir.path / "link.log");
+
+  std::vector<std::string> files;
+  std::string error;
+  REQUIRE(InputPaths::expand({a, (dir.path / "." / "a.log").string(), b,
+                              (dir.path / "link.log").string(), "-", "-"},
+                             files, error));
+  CHECK(files == std::vector<std::string>{a, b, "-"});
+}
+
+TEST_CASE("InputPaths passes plain paths and stdin through", "[inputs]") {
+  std::vector<std::string> files;
+  std::string error;
+  REQUIRE(InputPaths::expand({"-", "/no/such/file.log"}, files, error));
+  CHECK(files == std::vector<std::string>{"-", "/no/such/file.log"});
+}
+
+TEST_CASE("InputPaths reports a glob that matches nothing", "[inputs]") {
+  TempDir dir;
+  std::vector<std::string> files;
+  std::string error;
+  CHECK_FALSE(
+      InputPaths::expand({(dir.path / "*.log").string()}, files, error));
+  CHECK(error.find("*.log") != std::string::npos);
+}
@@ -0,0 +1,95 @@
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "../io/LineScanner.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace loganalyzer;
+
+namespace {
+
+// Reference split matching the old find('\n') loop
+std::vector<std::pair<size_t, size_t>> referenceSplit(std::string_view data) {
+  std::vector<std::pair<size_t, size_t>> lines;
+  size_t pos = 0;
+  while (pos < data.size()) {
+    size_t nl = data.find('\n', pos);
+    if (nl == std::string_view::npos) {
+      lines.emplace_back(pos, data.size());
+      break;
+    }
+    lines.emplace_back(pos, nl);
+    pos = nl + 1;
+  }
+  return lines;
+}
+
+std::vector<std::pair<size_t, size_t>> scan(std::string_view data,
+                                            ScanKernel kernel,
+                                            size_t batchSize) {
+  std::vector<std::pair<size_t, size_t>> lines;
+  LineScanner scanner(data, kernel);
+  std::vector<LineSpan> spans(batchSize);
+  size_t count;
+  while ((count = scanner.nextBatch(spans.data(), batchSize)) > 0) {
+    for (size_t i = 0; i < count; ++i)
+      lines.emplace_back(spans[i].begin, spans[i].end);
+  }
+  CHECK(scanner.position() == data.size());
+  return lines;
+}
+
+std::vector<ScanKernel> supportedKernels() {
+  std::vector<ScanKernel> kernels;
+  for (ScanKernel k : {ScanKernel::Scalar, ScanKernel::SSE2, ScanKernel::AVX2})
+    if (LineScanner::isSupported(k))
+      kernels.push_back(k);
+  return kernels;
+}
+
+} // namespace
+
+TEST_CASE("LineScanner edge cases", "[scanner]") {
+  for (ScanKernel kernel : supportedKernels()) {
+    INFO("kernel: " << LineScanner::kernelName(kernel));
+
+    CHECK(scan("", kernel, 8).empty());
+    CHECK(scan("abc", kernel, 8) ==
+          std::vector<std::pair<size_t, size_t>>{{0, 3}});
+    CHECK(scan("abc\n", kernel, 8) ==
+          std::vector<std::pair<size_t, size_t>>{{0, 3}});
+    CHECK(scan("\n\n", kernel, 8) ==
+          std::vector<std::pair<size_t, size_t>>{{0, 0}, {1, 1}});
+    CHECK(scan("a\r\nb", kernel, 1) ==
+          std::vector<std::pair<size_t, size_t>>{{0, 2}, {3, 4}});
+  }
+}
+
+TEST_CASE("LineScanner matches find loop around block boundaries",
+          "[scanner]") {
+  for (ScanKernel kernel : supportedKernels()) {
+    INFO("kernel: " << LineScanner::kernelName(kernel));
+    for (size_t nlPos : {0, 62, 63, 64, 65, 127, 128, 4095, 4096, 4097}) {
+      std::string data(nlPos + 70, 'x');
+      data[nlPos] = '\n';
+      CHECK(scan(data, kernel, 3) == referenceSplit(data));
+    }
+  }
+}
+
+TEST_CASE("LineScanner matches find loop on random data", "[scanner]") {
+  std::mt19937 rng(1234);
+  for (size_t size : {1, 17, 64, 100, 5000, 70000}) {
+    std::string data(size, 'a');
+    for (char &c : data) {
+      unsigned r = rng() % 16;
+      c = r == 0 ? '\n' : static_cast<char>(r == 1 ? '\r' : 'a' + r);
+    }
+    auto expected = referenceSplit(data);
+    for (ScanKernel kernel : supportedKernels()) {
+      INFO("kernel: " << LineScanner::kernelName(kernel) << " size: " << size);
+      CHECK(scan(data, kernel, 7) == expected);
+      CHECK(scan(data, kernel, 1024) == expected);
+    }
+  }
+}
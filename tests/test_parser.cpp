@@ -27,12 +27,12 @@ bool test_valid_log_entry() {
               "Should parse valid entry");
 
   const LogEntry &entry = std::get<LogEntry>(result);
-  ASSERT_EQ(2026, entry.ts.year, "Year should match");
-  ASSERT_EQ(1, entry.ts.month, "Month should match");
-  ASSERT_EQ(5, entry.ts.day, "Day should match");
-  ASSERT_EQ(10, entry.ts.hour, "Hour should match");
-  ASSERT_EQ(30, entry.ts.minute, "Minute should match");
-  ASSERT_EQ(15, entry.ts.second, "Second should match");
+  ASSERT_EQ(2026, entry.ts.year(), "Year should match");
+  ASSERT_EQ(1, entry.ts.month(), "Month should match");
+  ASSERT_EQ(5, entry.ts.day(), "Day should match");
+  ASSERT_EQ(10, entry.ts.hour(), "Hour should match");
+  ASSERT_EQ(30, entry.ts.minute(), "Minute should match");
+  ASSERT_EQ(15, entry.ts.second(), "Second should match");
   ASSERT_TRUE(entry.level == LogLevel::ERROR, "Level should be ERROR");
   ASSERT_TRUE(entry.message == "Database connection failed",
               "Message should match");
@@ -1,6 +1,9 @@
 #include "../core/StandardLogParser.h"
 #include "../core/Timestamp.h"
+#include "../core/TimestampCache.h"
 #include "../external/catch2/catch_amalgamated.hpp"
+#include <cstdio>
+#include <string>
 
 using namespace loganalyzer;
 
@@ -12,12 +15,12 @@ TEST_CASE("LogParser validates valid log entries", "[parser]") {
   REQUIRE(std::holds_alternative<LogEntry>(result));
 
   const LogEntry &entry = std::get<LogEntry>(result);
-  CHECK(entry.ts.year == 2026);
-  CHECK(entry.ts.month == 1);
-  CHECK(entry.ts.day == 5);
-  CHECK(entry.ts.hour == 10);
-  CHECK(entry.ts.minute == 30);
-  CHECK(entry.ts.second == 15);
+  CHECK(entry.ts.year() == 2026);
+  CHECK(entry.ts.month() == 1);
+  CHECK(entry.ts.day() == 5);
+  CHECK(entry.ts.hour() == 10);
+  CHECK(entry.ts.minute() == 30);
+  CHECK(entry.ts.second() == 15);
   CHECK(entry.level == LogLevel::ERROR);
   CHECK(entry.message == "Database connection failed");
 }
@@ -91,9 +94,9 @@ TEST_CASE("Timestamp validation rejects invalid dates", "[timestamp]") {
 
   SECTION("29 February in leap year is accepted") {
     CHECK(Timestamp::parse("2024-02-29 10:30:15", ts));
-    CHECK(ts.year == 2024);
-    CHECK(ts.month == 2);
-    CHECK(ts.day == 29);
+    CHECK(ts.year() == 2024);
+    CHECK(ts.month() == 2);
+    CHECK(ts.day() == 29);
   }
 
   SECTION("31 April is rejected") {
@@ -101,6 +104,184 @@ TEST_CASE("Timestamp validation rejects invalid dates", "[timestamp]") {
   }
 }
 
+TEST_CASE("Timestamp packs to epoch seconds", "[timestamp]") {
+  CHECK(sizeof(Timestamp) == 8);
+
+  SECTION("Known epoch values") {
+    CHECK(Timestamp(1970, 1, 1).epochSeconds() == 0);
+    CHECK(Timestamp(2000, 3, 1, 0, 0, 1).epochSeconds() == 951868801);
+    CHECK(Timestamp(2026, 1, 5, 10, 30, 15).epochSeconds() == 1767609015);
+    CHECK(Timestamp(1969, 12, 31, 23, 59, 59).epochSeconds() == -1);
+  }
+
+  SECTION("Calendar fields round-trip through parse") {
+    for (const char *text : {"2024-02-29 23:59:59", "1999-12-31 00:00:00",
+                             "2000-02-29 12:00:00", "1900-03-01 01:02:03",
+                             "0001-01-01 00:00:00", "9999-12-31 23:59:59"}) {
+      Timestamp ts;
+      REQUIRE(Timestamp::parse(text, ts));
+      CHECK(ts.toString() == text);
+    }
+  }
+
+  SECTION("Minute bucket, hour and day of week") {
+    Timestamp ts(2026, 1, 5, 10, 30, 15); // Monday
+    CHECK(ts.minuteBucket() == Timestamp(2026, 1, 5, 10, 30).epochSeconds());
+    CHECK(ts.hourOfDay() == 10);
+    CHECK(ts.dayOfWeek() == 1);
+    CHECK(Timestamp(2026, 1, 4).dayOfWeek() == 0);   // Sunday
+    CHECK(Timestamp(1969, 12, 31).dayOfWeek() == 3); // Wednesday
+    CHECK(Timestamp(1969, 12, 31, 23, 59, 59).minuteBucket() == -60);
+  }
+
+  SECTION("Default timestamp is invalid and orders first") {
+    Timestamp invalid;
+    CHECK_FALSE(invalid.isValid());
+    CHECK(invalid < Timestamp(1, 1, 1));
+    CHECK(Timestamp(2026, 1, 5).isValid());
+  }
+}
+
+TEST_CASE("Timestamp fast path matches scalar reference", "[timestamp]") {
+  auto agree = [](const std::string &text) {
+    Timestamp fast{}, ref{};
+    bool fastOk = Timestamp::parse(text, fast);
+    bool refOk = Timestamp::parseScalar(text, ref);
+    INFO(text);
+    REQUIRE(fastOk == refOk);
+    if (fastOk)
+      REQUIRE(fast == ref);
+  };
+
+  SECTION("Every day, month and edge time around the calendar limits") {
+    char buf[32];
+    for (int year : {1900, 1999, 2000, 2023, 2024, 2100, 9999}) {
+      for (int month = 0; month <= 13; ++month) {
+        for (int day = 0; day <= 32; ++day) {
+          std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d 23:59:59", year,
+                        month, day);
+          agree(buf);
+        }
+      }
+    }
+    for (const char *time :
+         {"00:00:00", "23:59:59", "24:00:00", "23:60:00", "23:59:60",
+          "99:99:99", "09:05:07"}) {
+      agree(std::string("2024-02-29 ") + time);
+    }
+  }
+
+  SECTION("Single-byte corruptions") {
+    // '-' is left out of the replacement set: from_chars in the scalar
+    // reference accepts a sign in a numeric field ("-0"), the fast path
+    // only accepts digits.
+    const std::string valid = "2024-02-29 10:30:15";
+    const char replacements[] = {'0', '5', '9', ' ', ':', '/', '.', 'a',
+                                 '\0', '\n', '\x7f', '\xff', '+', '*'};
+    for (size_t pos = 0; pos < valid.size(); ++pos) {
+      for (char c : replacements) {
+        std::string text = valid;
+        text[pos] = c;
+        agree(text);
+      }
+    }
+  }
+
+  SECTION("Wrong lengths are rejected") {
+    Timestamp ts;
+    CHECK_FALSE(Timestamp::parse("2024-02-29 10:30:1", ts));
+    CHECK_FALSE(Timestamp::parse("2024-02-29 10:30:150", ts));
+    CHECK_FALSE(Timestamp::parse("", ts));
+  }
+}
+
+TEST_CASE("TimestampCache reuses the minute prefix", "[timestamp]") {
+  TimestampCache cache;
+  Timestamp ts;
+
+  REQUIRE(cache.parse("2024-02-29 10:30:15", ts));
+  CHECK(cache.misses() == 1);
+
+  SECTION("Same minute only re-parses the seconds") {
+    REQUIRE(cache.parse("2024-02-29 10:30:59", ts));
+    CHECK(ts == Timestamp(2024, 2, 29, 10, 30, 59));
+    REQUIRE(cache.parse("2024-02-29 10:30:00", ts));
+    CHECK(ts == Timestamp(2024, 2, 29, 10, 30, 0));
+    CHECK(cache.hits() == 2);
+  }
+
+  SECTION("Invalid seconds are still rejected") {
+    CHECK_FALSE(cache.parse("2024-02-29 10:30:60", ts));
+    CHECK_FALSE(cache.parse("2024-02-29 10:30:1x", ts));
+    CHECK_FALSE(cache.parse("2024-02-29 10:30-15", ts));
+    CHECK(cache.hits() == 0);
+  }
+
+  SECTION("A new minute or a rejected line falls back to a full parse") {
+    REQUIRE(cache.parse("2024-02-29 10:31:00", ts));
+    CHECK(ts == Timestamp(2024, 2, 29, 10, 31, 0));
+    CHECK_FALSE(cache.parse("2023-02-29 10:31:00", ts));
+    REQUIRE(cache.parse("2024-02-29 10:31:05", ts));
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 3);
+  }
+
+  SECTION("Agrees with Timestamp::parse on a mixed sequence") {
+    for (const char *text :
+         {"2024-02-29 10:30:15", "2024-02-29 10:30:16", "2024-02-29 10:3O:17",
+          "2024-02-29 10:30:18", "2024-02-29 10:30:18 ", "2024-02-29 10:30",
+          "2024-03-01 00:00:00", "2024-03-01 00:00:59", "2024-03-31 00:00:59",
+          "2024-04-31 00:00:59"}) {
+      Timestamp fromCache, direct;
+      INFO(text);
+      CHECK(cache.parse(text, fromCache) == Timestamp::parse(text, direct));
+      if (Timestamp::parse(text, direct))
+        CHECK(fromCache == direct);
+    }
+  }
+}
+
+TEST_CASE("StandardLogParser reports timestamp cache stats", "[parser]") {
+  StandardLogParser parser;
+  parser.parse("[2026-01-05 10:30:15] [INFO] a", 1);
+  parser.parse("[2026-01-05 10:30:16] [INFO] b", 2);
+  parser.parse("[2026-01-05 10:31:00] [INFO] c", 3);
+
+  ParserStats stats = parser.stats();
+  CHECK(stats.timestampCacheHits == 1);
+  CHECK(stats.timestampCacheMisses == 2);
+}
+
+TEST_CASE("LogParser only extracts requested fields", "[parser]") {
+  StandardLogParser parser;
+
+  SECTION("Without timestamp a bad date is not validated") {
+    parser.setFields({false, true, true});
+    auto result = parser.parse("[2026-02-31 10:30:15] [INFO] hello", 1);
+    REQUIRE(std::holds_alternative<LogEntry>(result));
+    const auto &entry = std::get<LogEntry>(result);
+    CHECK_FALSE(entry.ts.isValid());
+    CHECK(entry.message == "hello");
+    CHECK(parser.stats().timestampCacheMisses == 0);
+  }
+
+  SECTION("Without level an unknown level is accepted") {
+    parser.setFields({true, false, false});
+    auto result = parser.parse("[2026-01-05 10:30:15] [DEBUG] hello", 1);
+    REQUIRE(std::holds_alternative<LogEntry>(result));
+    const auto &entry = std::get<LogEntry>(result);
+    CHECK(entry.ts == Timestamp(2026, 1, 5, 10, 30, 15));
+    CHECK(entry.message.empty());
+  }
+
+  SECTION("Structural errors are still reported") {
+    parser.setFields({});
+    auto result = parser.parse("2026-01-05 10:30:15 INFO hello world", 1);
+    REQUIRE(std::holds_alternative<ParseError>(result));
+    CHECK(std::get<ParseError>(result).code == ParseErrorCode::BadFormat);
+  }
+}
+
 TEST_CASE("LogParser handles edge cases", "[parser][edge]") {
   SECTION("Empty line is rejected") {
     StandardLogParser parser;
@@ -56,3 +56,84 @@ TEST_CASE("PatternLogParser - Failure Cases", "[Parser][Pattern]") {
     CHECK(error.code == ParseErrorCode::BadFormat);
   }
 }
+
+TEST_CASE("PatternLogParser - Compiled matcher", "[Parser][Pattern]") {
+  SECTION("Common patterns are compiled") {
+    CHECK(PatternLogParser("[%D %T] [%L] %M").isCompiled());
+    CHECK(PatternLogParser("%T - %L - %M").isCompiled());
+    CHECK(PatternLogParser("|%D| %L ... %M").isCompiled());
+    CHECK(PatternLogParser("<%L> %M (end)").isCompiled());
+  }
+
+  SECTION("Ambiguous patterns fall back to regex") {
+    CHECK_FALSE(PatternLogParser("%M - %L").isCompiled());
+    CHECK_FALSE(PatternLogParser("%T.%M").isCompiled());
+    CHECK_FALSE(PatternLogParser("%L_%M").isCompiled());
+    CHECK_FALSE(PatternLogParser("%L%T %M").isCompiled());
+  }
+
+  SECTION("Fractional seconds are matched and the timestamp is kept") {
+    PatternLogParser parser("[%D %T] [%L] %M");
+    auto result =
+        parser.parse("[2023-10-27 10:00:05.250] [WARN] Slow request", 1);
+
+    REQUIRE(std::holds_alternative<LogEntry>(result));
+    auto entry = std::get<LogEntry>(result);
+    CHECK(entry.level == LogLevel::WARNING);
+    CHECK(entry.message == "Slow request");
+    CHECK(entry.ts.year() == 2023);
+    CHECK(entry.ts.second() == 5);
+  }
+
+  SECTION("Closing literal after message") {
+    PatternLogParser parser("<%L> %M (end)");
+    auto result = parser.parse("<ERROR> disk (sda) failed (end)", 1);
+
+    REQUIRE(std::holds_alternative<LogEntry>(result));
+    CHECK(std::get<LogEntry>(result).message == "disk (sda) failed");
+    CHECK(std::holds_alternative<ParseError>(parser.parse("<ERROR> x", 2)));
+  }
+
+  SECTION("Accepts exactly the lines the regex accepts") {
+    const char *patterns[] = {"[%D %T] [%L] %M", "%T - %L - %M",
+                              "|%D| %L ... %M", "%D %T %L: %M",
+                              "<%L> %M (end)", "%L"};
+    const char *lines[] = {
+        "[2023-10-27 10:00:00] [INFO] System started",
+        "[2023/10/27 10:00:00.5] [ERR] x",
+        "[2023-10-27 10:00:00.] [INFO] trailing dot",
+        "[2023-10-27 10:00:00] [INFO]",
+        "[2023-10-27 10:00:00] [] empty level",
+        "[2023-10-27 10:00:00] [INFO] tab\tand \r carriage return",
+        "14:30:15.500 - ERROR - Database connection lost",
+        "14:30:15 - ERROR - ",
+        "14:30 - ERROR - short time",
+        "|2023-11-01| WARNING ... Disk space low",
+        "2023-11-01 08:00:00 WARN: ready",
+        "2023-11-01 08:00:00 WARN_2: ready",
+        "<INFO> a (end)",
+        "<INFO> (end)",
+        "<INFO>  (end) (end)",
+        "WARNING",
+        "WARNING!",
+        "",
+    };
+
+    for (const char *p : patterns) {
+      PatternLogParser parser(p);
+      REQUIRE(parser.isCompiled());
+      // Whether a line is valid must not depend on the projected fields
+      PatternLogParser levelOnly(p);
+      levelOnly.setFields({false, true, false});
+      std::regex reference(parser.getRegexString());
+      for (const char *line : lines) {
+        INFO("pattern: " << p << " line: " << line);
+        bool expected = std::regex_match(line, reference);
+        CHECK(std::holds_alternative<LogEntry>(parser.parse(line, 1)) ==
+              expected);
+        CHECK(std::holds_alternative<LogEntry>(levelOnly.parse(line, 1)) ==
+              expected);
+      }
+    }
+  }
+}
@@ -0,0 +1,311 @@
+#include "../analysis/Pipeline.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "../io/MemoryMappedFile.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace loganalyzer;
+
+namespace {
+
+// ~10 MB spanning several morsels, with invalid lines scattered throughout
+// and a few lines long enough to make line lengths uneven
+std::string makeLog() {
+  static const char *kLevels[] = {"INFO", "WARNING", "ERROR"};
+  std::string log;
+  log.reserve(11 * 1024 * 1024);
+  char buf[128];
+  for (int i = 0; log.size() < 10 * 1024 * 1024; ++i) {
+    if (i % 997 == 0) {
+      log += "garbage line " + std::to_string(i) + "\n";
+      continue;
+    }
+    std::snprintf(buf, sizeof(buf),
+                  "[2026-01-%02d %02d:%02d:%02d] [%s] Event %d\n",
+                  1 + i / 86400 % 28, i / 3600 % 24, i / 60 % 60, i % 60,
+                  kLevels[i % 3], i % 50);
+    log += buf;
+    if (i % 5003 == 0)
+      log += "[2026-01-01 00:00:00] [INFO] " + std::string(3000, 'x') + "\n";
+  }
+  return log;
+}
+
+} // namespace
+
+TEST_CASE("Pipeline gives the same result on one and many threads",
+          "[pipeline]") {
+  const std::string log = makeLog();
+  TempFile file(log);
+
+  AnalysisContext single;
+  single.threads = 1;
+  AnalysisContext multi;
+  multi.threads = 4;
+
+  AnalysisResult a = Pipeline::run(file.path.string(), single);
+  AnalysisResult b = Pipeline::run(file.path.string(), multi);
+
+  REQUIRE(a.totalLines == static_cast<uint64_t>(
+                              std::count(log.begin(), log.end(), '\n')));
+  requireSameResult(a, b);
+  REQUIRE(a.invalidLines > 0);
+}
+
+TEST_CASE("Pipeline error samples carry absolute line numbers",
+          "[pipeline]") {
+  const std::string log = makeLog();
+  TempFile file(log);
+
+  AnalysisContext context;
+  context.threads = 4;
+  AnalysisResult result = Pipeline::run(file.path.string(), context);
+
+  size_t checked = 0;
+  for (const auto &[code, samples] : result.errorSamples) {
+    for (const auto &sample : samples) {
+      REQUIRE(sample.offset < log.size());
+      uint64_t expected =
+          std::count(log.begin(), log.begin() + sample.offset, '\n') + 1;
+      CHECK(sample.lineNumber == expected);
+      ++checked;
+    }
+  }
+  CHECK(checked > 0);
+}
+
+TEST_CASE("Pipeline stops when the stop token is set", "[pipeline]") {
+  TempFile file(makeLog());
+
+  std::atomic<bool> stop{true};
+  AnalysisContext context;
+  context.threads = 2;
+  context.stopToken = &stop;
+
+  bool finalProgress = false;
+  bool cancelled = false;
+  AnalysisResult result = Pipeline::run(
+      file.path.string(), context,
+      [&](float p) {
+        finalProgress = finalProgress || p == 1.0f;
+        return true;
+      },
+      &cancelled);
+
+  CHECK(cancelled);
+  CHECK_FALSE(finalProgress);
+  CHECK(result.totalLines == 0);
+}
+
+TEST_CASE("Pipeline reports no cancel after a complete run", "[pipeline]") {
+  TempFile file("[2026-01-05 10:30:15] [ERROR] Database connection timeout\n");
+
+  std::atomic<bool> stop{false};
+  AnalysisContext context;
+  context.stopToken = &stop;
+
+  bool cancelled = true;
+  AnalysisResult result =
+      Pipeline::run(file.path.string(), context, nullptr, &cancelled);
+
+  CHECK_FALSE(cancelled);
+  CHECK(result.parsedLines == 1);
+}
+
+TEST_CASE("Pipeline streams a FIFO with the same result as mmap",
+          "[pipeline]") {
+  const std::string log = makeLog();
+  TempFile file(log);
+
+  TempFifo fifo(log);
+
+  AnalysisContext context;
+  context.threads = 3;
+  AnalysisResult mapped = Pipeline::run(file.path.string(), context);
+  AnalysisResult streamed = Pipeline::run(fifo.path.string(), context);
+
+  requireSameResult(mapped, streamed);
+}
+
+TEST_CASE("Pipeline merges several files into one result", "[pipeline]") {
+  const std::string log = makeLog();
+  TempFile first(log);
+  TempFile second(log.substr(0, log.size() / 3));
+  TempFile third("garbage\n[2026-01-05 10:30:15] [ERROR] Disk full\n");
+
+  AnalysisContext context;
+  context.threads = 4;
+  std::vector<std::string> paths = {first.path.string(),
+                                    second.path.string(),
+                                    third.path.string()};
+  AnalysisResult merged = Pipeline::run(paths, context);
+
+  REQUIRE(merged.files.size() == 3);
+  uint64_t totalLines = 0;
+  uint64_t invalidLines = 0;
+  std::map<LogLevel, uint64_t> levelCounts;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    AnalysisResult single = Pipeline::run(paths[i], context);
+    const auto &file = merged.files[i];
+    CHECK(file.path == paths[i]);
+    CHECK(file.bytes == std::filesystem::file_size(paths[i]));
+    CHECK(file.totalLines == single.totalLines);
+    CHECK(file.parsedLines == single.parsedLines);
+    CHECK(file.invalidLines == single.invalidLines);
+    totalLines += single.totalLines;
+    invalidLines += single.invalidLines;
+    for (const auto &[level, count] : single.levelCounts)
+      levelCounts[level] += count;
+  }
+  CHECK(merged.totalLines == totalLines);
+  CHECK(merged.invalidLines == invalidLines);
+  CHECK(merged.levelCounts == levelCounts);
+
+  // Samples point into their own file
+  size_t checked = 0;
+  for (const auto &[code, samples] : merged.errorSamples) {
+    for (const auto &sample : samples) {
+      REQUIRE(sample.file < paths.size());
+      std::ifstream in(paths[sample.file], std::ios::binary);
+      std::string contents((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+      REQUIRE(sample.offset < contents.size());
+      CHECK(contents.compare(sample.offset, sample.line.size(), sample.line) ==
+            0);
+      CHECK(sample.lineNumber ==
+            static_cast<uint64_t>(std::count(contents.begin(),
+                                             contents.begin() + sample.offset,
+                                             '\n')) +
+                1);
+      ++checked;
+    }
+  }
+  CHECK(checked > 0);
+}
+
+TEST_CASE("Pipeline rejects a missing file among several", "[pipeline]") {
+  TempFile file("[2026-01-05 10:30:15] [ERROR] Disk full\n");
+  std::vector<std::string> paths = {file.path.string(),
+                                    file.path.string() + ".missing"};
+  CHECK_THROWS(Pipeline::run(paths, AnalysisContext{}));
+}
+
+TEST_CASE("Pipeline takes a file named twice once", "[pipeline]") {
+  TempFile first("garbage\n[2026-01-05 10:30:15] [ERROR] Disk full\n");
+  TempFile second("[2026-01-05 10:30:16] [INFO] Started\n");
+
+  for (IoBackend io : {IoBackend::Mmap, IoBackend::Pread}) {
+    AnalysisContext context;
+    context.io = io;
+    // The same file again under another spelling
+    const std::string again =
+        (second.path.parent_path() / "." / second.path.filename()).string();
+    AnalysisResult result = Pipeline::run(
+        {second.path.string(), first.path.string(), again}, context);
+
+    CHECK(result.totalLines == 3);
+    REQUIRE(result.files.size() == 2);
+    CHECK(result.files[0].path == second.path.string());
+    CHECK(result.files[1].path == first.path.string());
+    for (const auto &[code, samples] : result.errorSamples) {
+      for (const auto &sample : samples)
+        CHECK(sample.file == 1);
+    }
+  }
+
+  CHECK_THROWS(Pipeline::run(std::vector<std::string>{}, AnalysisContext{}));
+}
+
+TEST_CASE("Pipeline gives the same result with every mapping option",
+          "[pipeline]") {
+  TempFile file(makeLog());
+
+  AnalysisContext plain;
+  plain.threads = 3;
+  plain.mapReadahead = false;
+  AnalysisResult expected = Pipeline::run(file.path.string(), plain);
+
+  AnalysisContext tuned = plain;
+  tuned.mapReadahead = true;
+  tuned.mapPopulate = true;
+  tuned.mapHugePages = true;
+  AnalysisResult result = Pipeline::run(file.path.string(), tuned);
+
+  requireSameResult(expected, result);
+}
+
+TEST_CASE("MemoryMappedFile keeps its contents after dontNeed",
+          "[pipeline]") {
+  const std::string log = makeLog();
+  TempFile file(log);
+
+  MemoryMappedFile mapped(file.path.string(),
+                          {MemoryMappedFile::Access::Sequential});
+  REQUIRE(mapped.getView() == log);
+  mapped.willNeed(1000, 5 * 1024 * 1024);
+  mapped.dontNeed(12345, 6 * 1024 * 1024);
+  mapped.dontNeed(0, log.size());
+  CHECK(mapped.getView() == log);
+}
+
+TEST_CASE("Pipeline gives the same result with a windowed mapping",
+          "[pipeline]") {
+  // Lines far longer than the window overhang make windows grow
+  std::string log = makeLog();
+  log += "[2026-01-02 00:00:00] [ERROR] " + std::string(300000, 'y') + "\n";
+  log += makeLog().substr(0, 1024 * 1024);
+  log += "no newline at the end " + std::string(200000, 'z');
+  TempFile file(log);
+
+  AnalysisContext whole;
+  whole.threads = 3;
+  AnalysisResult expected = Pipeline::run(file.path.string(), whole);
+
+  AnalysisContext windowed = whole;
+  windowed.mapBudget = 1; // Smallest morsels
+  AnalysisResult result = Pipeline::run(file.path.string(), windowed);
+
+  requireSameResult(expected, result);
+}
+
+TEST_CASE("Pipeline gives the same result with the pread backend",
+          "[pipeline]") {
+  const std::string log = makeLog();
+  TempFile first(log);
+  TempFile second(log.substr(0, log.size() / 2));
+
+  AnalysisContext mapped;
+  mapped.threads = 3;
+  AnalysisContext pread = mapped;
+  pread.io = IoBackend::Pread;
+
+  std::vector<float> progress;
+  AnalysisResult expected = Pipeline::run(first.path.string(), mapped);
+  AnalysisResult result =
+      Pipeline::run(first.path.string(), pread, [&](float p) {
+        progress.push_back(p);
+        return true;
+      });
+
+  requireSameResult(expected, result);
+  REQUIRE_FALSE(progress.empty());
+  CHECK(std::is_sorted(progress.begin(), progress.end()));
+  CHECK(progress.back() == 1.0f);
+
+  std::vector<std::string> paths = {first.path.string(),
+                                    second.path.string()};
+  AnalysisResult mappedBoth = Pipeline::run(paths, mapped);
+  AnalysisResult preadBoth = Pipeline::run(paths, pread);
+  CHECK(preadBoth.totalLines == mappedBoth.totalLines);
+  CHECK(preadBoth.levelCounts == mappedBoth.levelCounts);
+  REQUIRE(preadBoth.files.size() == 2);
+  CHECK(preadBoth.files[0].path == paths[0]);
+  CHECK(preadBoth.files[1].bytes == mappedBoth.files[1].bytes);
+}
@@ -0,0 +1,125 @@
+#include "../analysis/PipelineBuilder.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "TestSupport.h"
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace loganalyzer;
+
+namespace {
+
+// Result slot of TenantCountAnalyzer
+struct TenantCounts {
+  std::map<std::string, uint64_t> counts;
+
+  void merge(const TenantCounts &other) {
+    for (const auto &[tenant, count] : other.counts)
+      counts[tenant] += count;
+  }
+};
+
+// Counts lines per "tenant=<name>" in the message
+class TenantCountAnalyzer final : public IAnalyzer {
+public:
+  explicit TenantCountAnalyzer(std::string slot = "tenants")
+      : slot_(std::move(slot)) {}
+
+  void process(const LogEntry &entry) override {
+    size_t pos = entry.message.find("tenant=");
+    if (pos == std::string_view::npos)
+      return;
+    std::string_view tenant = entry.message.substr(pos + 7);
+    counts_.counts[std::string(tenant.substr(0, tenant.find(' ')))]++;
+  }
+  void finalize(AnalysisResult &result) override {
+    result.custom.get<TenantCounts>(slot_).merge(counts_);
+  }
+  ParseFields requiredFields() const override { return {false, false, true}; }
+
+private:
+  std::string slot_;
+  TenantCounts counts_;
+};
+
+// Several morsels of lines for seven tenants; counts the lines per tenant
+std::string makeLog(std::map<std::string, uint64_t> &expected) {
+  std::string log;
+  char buf[128];
+  for (int i = 0; log.size() < 6 * 1024 * 1024; ++i) {
+    std::string tenant = "t";
+    tenant += std::to_string(i % 7 * i % 13);
+    std::snprintf(buf, sizeof(buf),
+                  "[2026-01-05 10:%02d:%02d] [INFO] request tenant=%s ok\n",
+                  i / 60 % 60, i % 60, tenant.c_str());
+    log += buf;
+    expected[tenant]++;
+  }
+  return log;
+}
+
+} // namespace
+
+TEST_CASE("ResultSlots merge by name and copy deeply", "[builder]") {
+  ResultSlots a;
+  a.get<TenantCounts>("tenants").counts["x"] = 2;
+
+  ResultSlots b;
+  b.get<TenantCounts>("tenants").counts["x"] = 3;
+  b.get<TenantCounts>("other").counts["y"] = 1;
+
+  ResultSlots copy = a;
+  a.merge(b);
+  CHECK(a.size() == 2);
+  CHECK(a.find<TenantCounts>("tenants")->counts.at("x") == 5);
+  CHECK(a.find<TenantCounts>("other")->counts.at("y") == 1);
+  CHECK(copy.find<TenantCounts>("tenants")->counts.at("x") == 2);
+  CHECK(copy.find<TenantCounts>("missing") == nullptr);
+}
+
+TEST_CASE("PipelineBuilder runs extra analyzers on every thread",
+          "[builder]") {
+  std::map<std::string, uint64_t> expected;
+  const std::string log = makeLog(expected);
+  TempFile file(log);
+
+  AnalysisContext context;
+  context.threads = 4;
+  context.keyword = "request";
+  AnalysisResult plain = Pipeline::run(file.path.string(), context);
+
+  std::atomic<int> instances{0};
+  PipelineBuilder builder(context);
+  builder.addAnalyzer<TenantCountAnalyzer>()
+      .addAnalyzer([&instances]() -> std::unique_ptr<IAnalyzer> {
+        ++instances;
+        return std::make_unique<TenantCountAnalyzer>("copy");
+      })
+      .onProgress([](float) { return true; });
+  AnalysisResult result = builder.run(file.path.string());
+
+  // Built-in results are unchanged
+  CHECK(result.totalLines == plain.totalLines);
+  CHECK(result.levelCounts == plain.levelCounts);
+  CHECK(result.keywordHits == plain.keywordHits);
+
+  const TenantCounts *tenants = result.custom.find<TenantCounts>("tenants");
+  REQUIRE(tenants != nullptr);
+  CHECK(tenants->counts == expected);
+  CHECK(result.custom.find<TenantCounts>("copy")->counts == expected);
+  CHECK(instances > 1);
+
+  // Files analyzed together, and buffers, merge the same way
+  TempFile copy(log);
+  AnalysisResult twice =
+      builder.run(std::vector<std::string>{file.path.string(),
+                                           copy.path.string()});
+  for (const auto &[tenant, count] :
+       twice.custom.find<TenantCounts>("tenants")->counts) {
+    CHECK(count == 2 * expected.at(tenant));
+  }
+  CHECK(builder.runBuffer(log).custom.find<TenantCounts>("tenants")->counts ==
+        expected);
+}
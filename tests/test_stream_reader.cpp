@@ -0,0 +1,87 @@
+#include "../external/catch2/catch_amalgamated.hpp"
+#include "../io/StreamReader.h"
+#include "TestSupport.h"
+#include <string>
+#include <vector>
+
+using namespace loganalyzer;
+
+namespace {
+
+// Reads every block, checking each one ends on a line boundary
+std::string drain(StreamReader &reader, size_t &blocks) {
+  std::string all;
+  blocks = 0;
+  while (StreamReader::Block *block = reader.next()) {
+    CHECK(block->offset == all.size());
+    CHECK(block->index == blocks);
+    all.append(block->view());
+    if (!all.empty() && all.back() != '\n') {
+      // Only the unterminated last line may end a block without '\n'
+      CHECK(reader.next() == nullptr);
+    }
+    reader.release(block);
+    ++blocks;
+  }
+  return all;
+}
+
+} // namespace
+
+TEST_CASE("StreamReader delivers line-aligned blocks in order", "[stream]") {
+  std::string input;
+  for (int i = 0; i < 2000; ++i)
+    input += "line " + std::to_string(i) + "\n";
+  input += "unterminated";
+
+  TempFifo fifo(input);
+  StreamReader reader(fifo.path.string(), 256, 3);
+  REQUIRE(reader.isOpen());
+
+  size_t blocks = 0;
+  CHECK(drain(reader, blocks) == input);
+  CHECK(blocks > 10);
+  CHECK_FALSE(reader.failed());
+}
+
+TEST_CASE("StreamReader grows a block for a line longer than the block",
+          "[stream]") {
+  std::string input = "short\n" + std::string(1000, 'x') + "\nend\n";
+
+  TempFifo fifo(input);
+  StreamReader reader(fifo.path.string(), 64, 2);
+  REQUIRE(reader.isOpen());
+
+  size_t blocks = 0;
+  CHECK(drain(reader, blocks) == input);
+}
+
+TEST_CASE("StreamReader treats pipes as streams, regular files not",
+          "[stream]") {
+  TempFile file("x\n");
+  CHECK(StreamReader::isStreamPath("-"));
+  CHECK_FALSE(StreamReader::isStreamPath(file.path.string()));
+  CHECK_FALSE(StreamReader::isStreamPath(file.path.string() + ".missing"));
+
+  TempFifo fifo("");
+  CHECK(StreamReader::isStreamPath(fifo.path.string()));
+  // Opening the FIFO lets the writer finish
+  StreamReader reader(fifo.path.string(), 64, 1);
+  CHECK(reader.next() == nullptr);
+}
+
+TEST_CASE("StreamReader reads a regular file in aligned blocks", "[stream]") {
+  std::string input;
+  for (int i = 0; i < 100000; ++i)
+    input += "line " + std::to_string(i) + "\n";
+  input += "unterminated";
+
+  TempFile file(input);
+  // Odd block size: reads start unaligned after every carried line
+  StreamReader reader(file.path.string(), 100000, 3);
+  REQUIRE(reader.isOpen());
+  size_t blocks = 0;
+  CHECK(drain(reader, blocks) == input);
+  CHECK(blocks > 10);
+  CHECK_FALSE(reader.failed());
+}
@@ -0,0 +1,89 @@
+#include "../analysis/ThreadPool.h"
+#include "../external/catch2/catch_amalgamated.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace loganalyzer;
+
+namespace {
+
+// Spin until every submitted task has run
+void waitFor(const std::atomic<int> &done, int expected) {
+  while (done.load() < expected)
+    std::this_thread::yield();
+}
+
+} // namespace
+
+TEST_CASE("ThreadPool runs every task once", "[pool]") {
+  ThreadPool pool(4);
+  REQUIRE(pool.size() == 4);
+
+  constexpr int kTasks = 1000;
+  std::vector<std::atomic<int>> runs(kTasks);
+  std::atomic<int> done{0};
+  std::atomic<bool> badIndex{false};
+
+  std::vector<ThreadPool::Task> tasks;
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back([&, i](unsigned worker) {
+      if (worker >= 4)
+        badIndex = true;
+      runs[i]++;
+      done++;
+    });
+  }
+  pool.submit(std::move(tasks));
+  waitFor(done, kTasks);
+
+  CHECK_FALSE(badIndex.load());
+  for (const auto &r : runs)
+    CHECK(r.load() == 1);
+}
+
+TEST_CASE("ThreadPool idle workers steal queued tasks", "[pool]") {
+  ThreadPool pool(2);
+
+  // The first half of the tasks lands in worker 0's queue. Its first task
+  // blocks until worker 1 has run more than its own share, which is only
+  // possible by stealing.
+  constexpr int kTasks = 8;
+  std::atomic<int> ranOnWorker1{0};
+  std::atomic<int> done{0};
+
+  std::vector<ThreadPool::Task> tasks;
+  tasks.push_back([&](unsigned worker) {
+    if (worker == 0) {
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (ranOnWorker1.load() <= kTasks / 2 &&
+             std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    }
+    done++;
+  });
+  for (int i = 1; i < kTasks; ++i) {
+    tasks.push_back([&](unsigned worker) {
+      if (worker == 1)
+        ranOnWorker1++;
+      done++;
+    });
+  }
+  pool.submit(std::move(tasks));
+  waitFor(done, kTasks);
+
+  CHECK(ranOnWorker1.load() > kTasks / 2);
+}
+
+TEST_CASE("ThreadPool is reusable across submissions", "[pool]") {
+  ThreadPool pool(3);
+  std::atomic<int> done{0};
+  for (int round = 0; round < 50; ++round) {
+    std::vector<ThreadPool::Task> tasks(7, [&](unsigned) { done++; });
+    pool.submit(std::move(tasks));
+    waitFor(done, (round + 1) * 7);
+  }
+  CHECK(done.load() == 350);
+}